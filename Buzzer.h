@@ -1,5 +1,11 @@
 #pragma once
 #include <Arduino.h>
+#include "BuzzerConfig.h"
+#include "BuzzerGpio.h"
+#include "BuzzerEngine.h"
+#include "BuzzerPattern.h"
+#include "BuzzerStats.h"
+#include "BuzzerTrace.h"
 
 /**
  * @file Buzzer.h
@@ -8,9 +14,18 @@
  * - Direct control: on(), off(), isOn()
  * - Blink engine: startBlink(on_ms, off_ms, repeat) where repeat==0 ⇒ infinite
  * - BuzzerPreset sounds: playPreset(BuzzerPreset, non_blocking, repeat)
- * - Non-blocking requires calling update() frequently (e.g., each loop()).
+ * - Custom patterns: playPattern(steps, repeat) with a ::BuzzerStep table in PROGMEM,
+ *   written by hand or built at compile time with BuzzerPattern.h
+ * - Morse text: playMorse(text, wpm, repeat), from RAM or F() strings
+ * - Non-blocking requires calling update() frequently (e.g., each loop()),
+ *   or tick(now, queue) from a timer interrupt (see BuzzerCommandQueue.h).
+ *
+ * Timing lives in ::BuzzerEngine (BuzzerEngine.h); StaticBuzzer.h offers the same engine with the
+ * pin and polarity fixed at compile time.
  *
  * Error handling is zero-allocation via ::BuzzerError (no String).
+ * Scheduler counters are available with BUZZER_ENABLE_STATS=1 (see BuzzerStats.h),
+ * an edge trace with BUZZER_ENABLE_TRACE=1 (see BuzzerTrace.h); build options go in BuzzerConfig.h.
  */
 
 /** @enum BuzzerError
@@ -20,26 +35,39 @@ enum class BuzzerError : uint8_t {
   None = 0,          ///< No error
   InvalidPin,        ///< PIN_NUM < 0 or unsupported
   InvalidActiveMode, ///< ACTIVE_MODE must be 0 or 1
-  NotInitialized     ///< Operation requires successful init()
+  NotInitialized,    ///< Operation requires successful init()
+  InvalidSampleRate, ///< PassiveBuzzer SAMPLE_HZ outside 1000..1000000
+  InvalidStream      ///< BuzzerStreamPlayer: data is not a BZS1 stream
 };
 
-/** @enum BuzzerPreset
- *  @brief BuzzerPreset audible patterns.
+/**
+ * @brief Hook called repeatedly while a blocking sound plays (see Buzzer::setIdleHook()).
+ * @param context Pointer given to setIdleHook()
  */
-enum class BuzzerPreset : uint8_t {
-  Init = 0,    ///< 1s ON, 0.1s OFF
-  Stop,        ///< Two short beeps
-  Warning1,    ///< 10 bursts; each burst: 20×(5ms ON, 5ms OFF) then 200ms pause
-  Warning2,    ///< 100ms ON, 100ms OFF
-  Warning3,    ///< 10×(25ms ON, 25ms OFF)
-
-  Heartbeat,   ///< Short pip every ~1s: ON 50ms, OFF 950ms (repeatable)
-  ErrorAlert,  ///< Triple: (ON 200ms, OFF 100ms)×3, then 1s pause
-  Success,     ///< Confirmation: ON 100ms, OFF 50ms, ON 400ms (once per repeat)
-  Alarm,       ///< Long ON siren-like: ON 2000ms, OFF 200ms (repeatable)
-  MorseSOS     ///< SOS in Morse (· · · — — — · · ·), 100ms unit timing
+typedef void (*BuzzerIdleHook)(void* context);
+
+/** @enum BuzzerEvent
+ *  @brief What a ::BuzzerEventHook is told about.
+ */
+enum class BuzzerEvent : uint8_t {
+  Repeat = 0, ///< A pass of a finite or infinite sound ended and the next one began (blink: next pulse)
+  On,         ///< Output went ON (edge events only)
+  Off,        ///< Output went OFF (edge events only)
+  Complete    ///< The last pass ended; the buzzer is idle
 };
 
+/**
+ * @brief Hook called from update() on sound events (see Buzzer::setEventHook()).
+ * @param context Pointer given to setEventHook()
+ * @param event   What happened
+ */
+typedef void (*BuzzerEventHook)(void* context, BuzzerEvent event);
+
+template <uint8_t CAPACITY> class BuzzerGroup;
+template <uint8_t CAPACITY> class BuzzerRequestQueue;
+template <uint8_t CAPACITY> class BuzzerBank;
+template <uint8_t SIZE> class BuzzerCommandQueue;
+
 /**
  * @class Buzzer
  * @brief Digital buzzer driver (active-HIGH or active-LOW).
@@ -87,8 +115,12 @@ public:
   /**
    * @brief Initialize hardware; sets OUTPUT and OFF.
    * @return true on success, false on invalid parameters.
+   * @note Resolves the pin's output register once (see BuzzerGpio.h); call init() again
+   *       after changing parameters.
+   * @note Leave the argument defaulted: it makes the link fail if the sketch and the library were
+   *       built with different options (see BuzzerConfig.h).
    */
-  bool init();
+  bool init(BuzzerBuildCheck = BuzzerBuildCheck());
 
   /** @brief Whether init() succeeded. */
   bool getInitFlag() const { return _initFlag; }
@@ -114,9 +146,19 @@ public:
   void off();
 
   /** @brief Software-tracked ON/OFF state. */
-  bool isOn() const { return _currentOn; }
+  bool isOn() const { return _engine.isOn(); }
 
   // -------------------- BuzzerPreset sounds (blocking, one pass per call) --------------------
+  // Each call plays the preset's table on the non-blocking engine and waits for it to finish,
+  // calling the idle hook (or yield()) meanwhile. A running non-blocking sound is replaced.
+
+  /**
+   * @brief Set the hook called while blocking sounds wait (nullptr ⇒ yield()).
+   * @param hook    Function to call, e.g. to kick a watchdog or update other buzzers
+   * @param context Passed back to @p hook
+   */
+  void setIdleHook(BuzzerIdleHook hook, void* context = nullptr) { _idleHook = hook; _idleContext = context; }
+
   /** @brief One long tone (startup OK). */
   void soundInit();
   /** @brief Two short beeps (stop/abort). */
@@ -132,7 +174,7 @@ public:
   void soundHeartbeat();
   /** @brief ErrorAlert: (ON 200ms, OFF 100ms)×3 then 1s pause (one sequence). */
   void soundErrorAlert();
-  /** @brief Success: ON 100ms, OFF 50ms, ON 400ms (one sequence). */
+  /** @brief Success: ON 100ms, OFF 50ms, ON 400ms, OFF 200ms (one sequence). */
   void soundSuccess();
   /** @brief Alarm: ON 2000ms, OFF 200ms (one cycle). */
   void soundAlarm();
@@ -149,6 +191,13 @@ public:
    */
   void startBlink(uint16_t on_ms, uint16_t off_ms, uint32_t repeat = 0);
 
+  /**
+   * @brief startBlink() with durations in microseconds.
+   * @note Needs setTimebase(BuzzerTimebase::Micros) for sub-millisecond resolution;
+   *       in the default timebase durations are rounded up to whole milliseconds.
+   */
+  void startBlinkUs(uint32_t on_us, uint32_t off_us, uint32_t repeat = 0);
+
   /** @brief Stop any running non-blocking blink; forces OFF. */
   void stopBlink();
 
@@ -159,51 +208,237 @@ public:
    * @param non_blocking true ⇒ run via update(); false ⇒ run blocking here
    * @param repeat       How many times to repeat the BuzzerPreset (0 ⇒ infinite in non-blocking mode)
    *
-   * In blocking mode, repeat must be >= 1.
+   * In blocking mode, repeat must be >= 1; the call returns when the sound has finished and
+   * calls the idle hook (see setIdleHook()) while it waits.
    */
   void playPreset(BuzzerPreset preset, bool non_blocking, uint32_t repeat = 1);
 
-  /** @brief Stop any running non-blocking BuzzerPreset; forces OFF. */
+  /**
+   * @brief How long playPreset(@p preset, ..., @p repeat) keeps the buzzer busy, in ms.
+   * @return IDLE_FOREVER for repeat == 0; a constant expression (see BuzzerPattern.h).
+   */
+  static constexpr unsigned long presetDurationMs(BuzzerPreset preset, uint32_t repeat = 1) {
+    return BuzzerPattern::presetDurationMs(preset, repeat);
+  }
+
+  /** @brief Stop any running non-blocking BuzzerPreset, pattern or Morse text; forces OFF. */
   void stopPreset();
 
+  /**
+   * @brief Play a custom ::BuzzerStep table in non-blocking mode.
+   * @param steps  PROGMEM table terminated with BuzzerStep::end()
+   * @param repeat How many passes to play (0 ⇒ infinite)
+   * @note Runs on the same engine as the presets; stopPreset() stops it.
+   */
+  void playPattern(const uint16_t* steps, uint32_t repeat = 1);
+
+  /**
+   * @brief playPattern() with step durations read as microseconds (1..16383 µs per step).
+   * @note Intended for BuzzerTimebase::Micros (see startBlinkUs()).
+   */
+  void playPatternUs(const uint16_t* steps, uint32_t repeat = 1);
+
+  /**
+   * @brief Key text in Morse code, non-blocking, encoding one character at a time.
+   * @param text   NUL-terminated text, read in place: it must stay valid while playing
+   * @param wpm    Speed in words per minute (12 ⇒ 100 ms dot, the MorseSOS preset timing)
+   * @param repeat How many passes to play (0 ⇒ infinite), separated by a word gap
+   * @note Letters, digits and common punctuation are keyed, other characters skipped.
+   *       stopPreset() stops it. Text with nothing to key (empty, spaces, only unknown
+   *       characters) still stops the running sound and leaves the buzzer idle and OFF.
+   */
+  void playMorse(const char* text, uint8_t wpm = 12, uint32_t repeat = 1);
+
+  /** @brief playMorse() for a flash string: bz.playMorse(F("ID 42")). */
+  void playMorse(const __FlashStringHelper* text, uint8_t wpm = 12, uint32_t repeat = 1);
+
   /// @return true if a non-blocking blink/preset is currently running.
-  bool isBusy() const { return _mode != Mode::Idle; }
+  bool isBusy() const { return _engine.isBusy(); }
 
   /// @brief Stop any activity (blink or preset) and turn OFF.
   void stopAll() { stopBlink(); stopPreset(); }
 
+  // -------------------- Low-power idle --------------------
+  /** @brief Returned by msUntilNextEvent()/usUntilNextEvent() when nothing is scheduled. */
+  static constexpr unsigned long IDLE_FOREVER = BuzzerEngine::IDLE_FOREVER;
+
+  /**
+   * @brief Clock value (of the selected timebase) at which update() has work to do next.
+   * @note Meaningful only while isBusy(); use msUntilNextEvent() for a sleep budget.
+   */
+  unsigned long nextEventAt() const { return _engine.deadline(); }
+
+  /**
+   * @brief How long the caller may sleep before the next update() is needed.
+   * @return Milliseconds (rounded down), 0 if an edge is due now, IDLE_FOREVER if idle
+   *
+   * @code
+   * void loop() {
+   *   bz.update();
+   *   sleepFor(min(bz.msUntilNextEvent(), otherWork));   // board-specific sleep
+   * }
+   * @endcode
+   */
+  unsigned long msUntilNextEvent() const {
+    const unsigned long t = _engine.timeUntilNext(_engine.now());
+    if (t == IDLE_FOREVER || _engine.timebase() == BuzzerTimebase::Millis) return t;
+    return t / 1000UL;
+  }
+
+  /** @brief Like msUntilNextEvent(), in microseconds (ms timebase values are scaled ×1000). */
+  unsigned long usUntilNextEvent() const {
+    const unsigned long t = _engine.timeUntilNext(_engine.now());
+    if (t == IDLE_FOREVER || _engine.timebase() == BuzzerTimebase::Micros) return t;
+    return t * 1000UL;
+  }
+
   // -------------------- Scheduler --------------------
+  /** @brief Select what happens when update() falls behind (default ::BuzzerCatchUp::Skip, see BuzzerEngine::setCatchUp()). */
+  void setCatchUp(BuzzerCatchUp policy) { _engine.setCatchUp(policy); }
+
+  /** @brief Current late-update policy. */
+  BuzzerCatchUp catchUp() const { return _engine.catchUp(); }
+
+  /**
+   * @brief Schedule on millis() (default) or micros() for sub-millisecond patterns.
+   * @note Stops a running sound. The setting survives init().
+   */
+  void setTimebase(BuzzerTimebase timebase) {
+    const bool was = _engine.isOn();
+    _engine.setTimebase(timebase);
+    if (_initFlag) _sync(was);
+#if BUZZER_ENABLE_TRACE
+    _trace.reset(_engine.isOn(), _engine.now()); // deltas of both clocks must not mix
+#endif
+  }
+
+  /** @brief Current scheduling clock. */
+  BuzzerTimebase timebase() const { return _engine.timebase(); }
+
   /** @brief Advance non-blocking engines (blink/BuzzerPreset). Call from loop(). */
   void update();
 
+  /**
+   * @brief Advance non-blocking engines using a caller-supplied clock reading.
+   * @param now Current clock value of the selected timebase, millis() by default
+   *            (lets several buzzers share one clock read)
+   */
+  void update(unsigned long now);
+
+  /**
+   * @brief Set the hook told about sound events, or nullptr to remove it.
+   * @param hook    Function to call
+   * @param context Passed back to @p hook
+   * @param edges   Also report every output edge (BuzzerEvent::On/Off)
+   *
+   * Events come from update() (also through BuzzerGroup, BuzzerBank and tick(), where the hook
+   * runs in the interrupt) once the pin has been written, in the order Repeat, On/Off, Complete.
+   * Boundaries crossed by one Skip catch-up are reported once. Sounds stopped or replaced by a
+   * command report nothing. The hook may start the next sound:
+   * @code
+   * void onEvent(void* ctx, BuzzerEvent e) {
+   *   if (e == BuzzerEvent::Complete) static_cast<Buzzer*>(ctx)->playPreset(BuzzerPreset::Success, true);
+   * }
+   * bz.setEventHook(onEvent, &bz);
+   * @endcode
+   */
+  void setEventHook(BuzzerEventHook hook, void* context = nullptr, bool edges = false) {
+    _eventHook = hook;
+    _eventContext = context;
+    _edgeEvents = edges;
+    _pendingEvents = 0;
+  }
+
+  /**
+   * @brief Interrupt-driven scheduler entry: apply queued commands, then advance the engines.
+   * @param now   Current clock value of the selected timebase, millis() by default
+   * @param queue Commands posted by the main loop (see BuzzerCommandQueue.h)
+   *
+   * Meant to run from a periodic timer interrupt (e.g. 1 kHz), so that edge timing no longer
+   * depends on how often loop() runs. While tick() drives a buzzer, the main loop must only
+   * talk to it through @p queue.
+   */
+  template <uint8_t SIZE>
+  void tick(unsigned long now, BuzzerCommandQueue<SIZE>& queue);
+
+#if BUZZER_ENABLE_STATS
+  // -------------------- Stats (BUZZER_ENABLE_STATS) --------------------
+  /**
+   * @brief Copy of the scheduler counters since init() or resetStats().
+   *
+   * @code
+   * const BuzzerStats s = bz.stats();
+   * if (s.misses) Serial.println(s.maxLateness);   // loop() too slow for the running sound
+   * @endcode
+   */
+  BuzzerStats stats() const { return _stats.snapshot(_engine.now()); }
+
+  /** @brief Zero the counters. */
+  void resetStats() { _stats.reset(_engine.now()); }
+#endif
+
+#if BUZZER_ENABLE_TRACE
+  // -------------------- Edge trace (BUZZER_ENABLE_TRACE) --------------------
+  /** @brief Output edges recorded since init() or clearTrace(), newest last. */
+  const BuzzerTrace& trace() const { return _trace; }
+
+  /** @brief Print the trace in the BZT1 text format, e.g. bz.dumpTrace(Serial). */
+  void dumpTrace(Print& out) const { _trace.dump(out, _engine.timebase() == BuzzerTimebase::Micros); }
+
+  /** @brief Drop the recorded edges. */
+  void clearTrace() { _trace.reset(_engine.isOn(), _engine.now()); }
+#endif
+
 private:
+  template <uint8_t CAPACITY> friend class BuzzerGroup;
+  template <uint8_t CAPACITY> friend class BuzzerRequestQueue;
+  template <uint8_t CAPACITY> friend class BuzzerBank;
+  template <uint8_t LAYERS> friend class BuzzerMixer;
+  template <uint8_t BUFFER> friend class BuzzerStreamPlayer;
+
   // ---- helpers / validation ----
   bool _checkParameters();
   inline uint8_t _onLevel()  const { return parameters.ACTIVE_MODE ? HIGH : LOW;  }
   inline uint8_t _offLevel() const { return parameters.ACTIVE_MODE ? LOW  : HIGH; }
+  inline void _write(bool on) {
+    _gpio.write(on ? _onLevel() : _offLevel());
+#if BUZZER_ENABLE_STATS || BUZZER_ENABLE_TRACE
+    _record(on, _engine.now());
+#endif
+  }
+  /** @brief Feed an output change at @p t to the stats/trace recorders (no-op without them). */
+  inline void _record(bool on, unsigned long t) {
+    (void)on; (void)t;
+#if BUZZER_ENABLE_STATS
+    _stats.level(on, t);
+#endif
+#if BUZZER_ENABLE_TRACE
+    _trace.record(on, t);
+#endif
+  }
+  inline void _sync(bool was) { if (_engine.isOn() != was) _write(_engine.isOn()); }
+  /** @brief update(now) without the pin write. @return true if the output level changed. */
+  bool _advance(unsigned long now);
+  /** @brief Deliver the events noted by the last _advance() (call once the pin is written). */
+  inline void _fireEvents() { if (_pendingEvents) _dispatchEvents(); }
+  void _dispatchEvents();
+  void _playBlocking(BuzzerPreset preset, uint32_t repeat);
 
-  // ---- global engine mode ----
-  enum class Mode : uint8_t { Idle = 0, Blink, Preset };
-  Mode _mode = Mode::Idle;
-
-  // ---- common state ----
+  // ---- state ----
+  BuzzerEngine      _engine;        ///< blink/preset timing
+  BuzzerDefaultGpio _gpio;          ///< resolved output (port/mask or pin)
   bool        _initFlag  = false;
-  bool        _currentOn = false;
   BuzzerError _lastError = BuzzerError::None;
-
-  // ---- blink state ----
-  bool           _blinkOnPhase = false;
-  uint16_t       _blinkOnMs = 0;
-  uint16_t       _blinkOffMs = 0;
-  uint32_t       _blinkRemain = 0;     ///< Remaining ON pulses; 0 ⇒ infinite
-  unsigned long  _nextToggleMs = 0;
-
-  // ---- BuzzerPreset state (non-blocking) ----
-  BuzzerPreset         _preset = BuzzerPreset::Init;
-  uint32_t       _presetRepeatRemain = 0;  ///< Remaining preset repeats; 0 ⇒ infinite
-
-  // Fine-grained sub-state for complex patterns:
-  uint8_t        _step = 0;     ///< generic step index inside a preset
-  uint8_t        _sub  = 0;     ///< inner loop counter (e.g., pulses)
-  uint8_t        _burst= 0;     ///< outer loop counter (for Warning1 / SOS groups)
+  BuzzerIdleHook _idleHook = nullptr;   ///< called while blocking sounds wait
+  void*          _idleContext = nullptr;
+  BuzzerEventHook _eventHook = nullptr; ///< see setEventHook()
+  void*           _eventContext = nullptr;
+  bool            _edgeEvents = false;
+  uint8_t         _pendingEvents = 0;   ///< EVENT_xxx bits noted by _advance()
+#if BUZZER_ENABLE_STATS
+  BuzzerStatsRecorder _stats;
+#endif
+#if BUZZER_ENABLE_TRACE
+  BuzzerTrace _trace;
+#endif
 };
@@ -0,0 +1,162 @@
+#pragma once
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerBank.h
+ * @brief Buzzers sharing output ports, updated together with one register write per port.
+ *
+ * update() reads the clock once, advances every due member, gathers the resulting level
+ * changes into set/clear masks per output port and applies each port's masks in a single
+ * (interrupt-safe) register update. Channels that switch at the same deadline therefore
+ * change in the same instruction, and an update costs one write per port instead of one per pin.
+ *
+ * - Members are referenced, not owned, must be init()-ed before add() (remove() and add() again
+ *   after changing PIN_NUM) and must outlive the bank.
+ * - All members must use the same ::BuzzerTimebase; the bank reads that clock once per update().
+ * - Commands (startBlink(), playPreset(), stopXxx(), ...) still write their own pin at once;
+ *   only scheduled edges are batched.
+ * - Batching needs AVR port registers (BUZZER_GPIO_PORT, see BuzzerGpio.h). Elsewhere each
+ *   changed member is written on its own, with the same timing.
+ *
+ * @code
+ * Buzzer leds[8];                        // pins 2..9
+ * BuzzerBank<8> bank;
+ * for (uint8_t i = 0; i < 8; ++i) {
+ *   leds[i].parameters.PIN_NUM = 2 + i;
+ *   leds[i].init();
+ *   bank.add(leds[i]);
+ *   leds[i].startBlink(100, 100 + 50 * i, 0);
+ * }
+ *
+ * void loop() {
+ *   bank.update(); // instead of leds[0].update(); leds[1].update(); ...
+ * }
+ * @endcode
+ */
+template <uint8_t CAPACITY>
+class BuzzerBank {
+  static_assert(CAPACITY > 0 && CAPACITY < 255, "BuzzerBank: CAPACITY must be 1..254");
+
+public:
+  BuzzerBank() = default;
+
+  /**
+   * @brief Register an initialized buzzer.
+   * @return false if the bank is full, @p bz is not initialized, already a member,
+   *         or its pin has no output port.
+   */
+  bool add(Buzzer& bz) {
+    if (_count >= CAPACITY || !bz.getInitFlag() || _indexOf(bz) >= 0) return false;
+    Member& m = _members[_count];
+    m.bz = &bz;
+#if BUZZER_GPIO_PORT
+    const uint8_t port = digitalPinToPort(bz.parameters.PIN_NUM);
+    if (port == NOT_A_PIN) return false;
+    volatile uint8_t* out = portOutputRegister(port);
+    uint8_t p = 0;
+    while (p < _portCount && _ports[p] != out) ++p;
+    if (p == _portCount) _ports[_portCount++] = out;
+    m.port = p;
+    m.mask = digitalPinToBitMask(bz.parameters.PIN_NUM);
+#endif
+    _count++;
+    return true;
+  }
+
+  /** @brief Unregister a buzzer (its sound keeps its state but is no longer serviced). */
+  bool remove(Buzzer& bz) {
+    const int i = _indexOf(bz);
+    if (i < 0) return false;
+    _members[i] = _members[--_count];
+#if BUZZER_GPIO_PORT
+    _compactPorts();
+#endif
+    return true;
+  }
+
+  /** @brief Service every due member using a single clock read. */
+  void update() {
+    if (_count == 0) return;
+    update(_members[0].bz->_engine.now());
+  }
+
+  /** @brief Service every member due at @p now (timebase ticks). */
+  void update(unsigned long now) {
+#if BUZZER_GPIO_PORT
+    uint8_t set[CAPACITY];
+    uint8_t clr[CAPACITY];
+    for (uint8_t p = 0; p < _portCount; ++p) set[p] = clr[p] = 0;
+
+    for (uint8_t i = 0; i < _count; ++i) {
+      Buzzer& bz = *_members[i].bz;
+      if (!bz._advance(now)) continue;
+      const bool on = bz._engine.isOn();
+      if ((on ? bz._onLevel() : bz._offLevel()) == HIGH) set[_members[i].port] |= _members[i].mask;
+      else                                              clr[_members[i].port] |= _members[i].mask;
+      bz._record(on, now);
+    }
+
+    for (uint8_t p = 0; p < _portCount; ++p) {
+      if ((set[p] | clr[p]) == 0) continue;
+#if defined(__AVR__)
+      // Same guard as BuzzerPortGpio: other pins of the port may be written from interrupts.
+      const uint8_t sreg = SREG;
+      cli();
+#endif
+      *_ports[p] = (uint8_t)((*_ports[p] & (uint8_t)~clr[p]) | set[p]);
+#if defined(__AVR__)
+      SREG = sreg;
+#endif
+    }
+    for (uint8_t i = 0; i < _count; ++i) _members[i].bz->_fireEvents();
+#else
+    for (uint8_t i = 0; i < _count; ++i) {
+      Buzzer& bz = *_members[i].bz;
+      if (bz._advance(now)) bz._write(bz._engine.isOn());
+      bz._fireEvents();
+    }
+#endif
+  }
+
+  /** @brief Stop every member (each pin is written as the sound stops). */
+  void stopAll() {
+    for (uint8_t i = 0; i < _count; ++i) _members[i].bz->stopAll();
+  }
+
+  /** @brief Number of registered buzzers. */
+  uint8_t size() const { return _count; }
+
+  /** @brief Number of distinct output registers written by update() (0 without BUZZER_GPIO_PORT). */
+  uint8_t portCount() const { return _portCount; }
+
+private:
+  struct Member {
+    Buzzer* bz = nullptr;
+    uint8_t port = 0;   ///< index into _ports
+    uint8_t mask = 0;   ///< pin bit in that port
+  };
+
+  Member            _members[CAPACITY];
+  volatile uint8_t* _ports[CAPACITY] = {};
+  uint8_t           _count = 0;
+  uint8_t           _portCount = 0;
+
+  int _indexOf(const Buzzer& bz) const {
+    for (uint8_t i = 0; i < _count; ++i) if (_members[i].bz == &bz) return i;
+    return -1;
+  }
+
+#if BUZZER_GPIO_PORT
+  /** @brief Drop ports no member uses any more, keeping member port indices valid. */
+  void _compactPorts() {
+    for (uint8_t p = 0; p < _portCount; ) {
+      bool used = false;
+      for (uint8_t i = 0; i < _count && !used; ++i) used = _members[i].port == p;
+      if (used) { ++p; continue; }
+      --_portCount;
+      _ports[p] = _ports[_portCount];
+      for (uint8_t i = 0; i < _count; ++i) if (_members[i].port == _portCount) _members[i].port = p;
+    }
+  }
+#endif
+};
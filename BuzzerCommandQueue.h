@@ -0,0 +1,114 @@
+#pragma once
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerCommandQueue.h
+ * @brief Lock-free single-producer/single-consumer command queue for interrupt-driven buzzers.
+ *
+ * The main loop (producer) posts commands; a timer interrupt (consumer) applies them through
+ * Buzzer::tick(). Neither side disables interrupts: each index is written by one side only and
+ * published with release/acquire ordering.
+ *
+ * @code
+ * Buzzer bz;
+ * BuzzerCommandQueue<8> cmds;
+ *
+ * ISR(TIMER2_COMPA_vect) { bz.tick(millis(), cmds); }   // ~1 kHz
+ *
+ * void loop() {
+ *   if (alarm) cmds.playPreset(BuzzerPreset::Alarm, 3);
+ *   longBlockingWork();   // edges keep their timing
+ * }
+ * @endcode
+ */
+
+/**
+ * @class BuzzerCommandQueue
+ * @brief Fixed-size SPSC ring of ::BuzzerCommand.
+ * @tparam SIZE Slot count, power of two (holds SIZE-1 commands)
+ */
+template <uint8_t SIZE>
+class BuzzerCommandQueue {
+  static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "BuzzerCommandQueue: SIZE must be a power of two >= 2");
+
+public:
+  BuzzerCommandQueue() = default;
+
+  // -------------------- Producer side (main loop) --------------------
+  /**
+   * @brief Post a command.
+   * @return false if the queue is full (command dropped).
+   */
+  bool push(const BuzzerCommand& cmd) {
+    const uint8_t head = _head;  // only the producer writes _head
+    const uint8_t next = (uint8_t)((head + 1) & (SIZE - 1));
+    if (next == __atomic_load_n(&_tail, __ATOMIC_ACQUIRE)) return false;
+    _slots[head] = cmd;
+    __atomic_store_n(&_head, next, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /** @brief Post Buzzer::startBlink(). */
+  bool startBlink(uint16_t on_ms, uint16_t off_ms, uint32_t repeat = 0) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::StartBlink;
+    c.onMs = on_ms; c.offMs = off_ms; c.repeat = repeat;
+    return push(c);
+  }
+
+  /** @brief Post a non-blocking Buzzer::playPreset(). */
+  bool playPreset(BuzzerPreset preset, uint32_t repeat = 1) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::PlayPreset;
+    c.preset = preset; c.repeat = repeat;
+    return push(c);
+  }
+
+  /** @brief Post Buzzer::playPattern(). */
+  bool playPattern(const uint16_t* steps, uint32_t repeat = 1) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::PlayPattern;
+    c.pattern = steps; c.repeat = repeat;
+    return push(c);
+  }
+
+  /** @brief Post Buzzer::stopAll(). */
+  bool stop() {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::Stop;
+    return push(c);
+  }
+
+  // -------------------- Consumer side (interrupt) --------------------
+  /**
+   * @brief Take the oldest command.
+   * @return false if the queue is empty.
+   */
+  bool pop(BuzzerCommand& out) {
+    const uint8_t tail = _tail;  // only the consumer writes _tail
+    if (tail == __atomic_load_n(&_head, __ATOMIC_ACQUIRE)) return false;
+    out = _slots[tail];
+    __atomic_store_n(&_tail, (uint8_t)((tail + 1) & (SIZE - 1)), __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /** @brief Whether no command is pending (approximate when read from the other side). */
+  bool empty() const {
+    return __atomic_load_n(&_head, __ATOMIC_ACQUIRE) == __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+  }
+
+private:
+  BuzzerCommand _slots[SIZE];
+  uint8_t _head = 0; ///< next slot to write (producer)
+  uint8_t _tail = 0; ///< next slot to read (consumer)
+};
+
+template <uint8_t SIZE>
+void Buzzer::tick(unsigned long now, BuzzerCommandQueue<SIZE>& queue) {
+  if (!_initFlag) return;
+  const bool was = _engine.isOn();
+  BuzzerCommand cmd;
+  while (queue.pop(cmd)) _engine.apply(cmd, now);
+  _sync(was);
+  update(now);
+}
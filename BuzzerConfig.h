@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file BuzzerConfig.h
+ * @brief Build options of the library, in one place seen by the sketch and the library sources.
+ *
+ * Options that change the layout of ::Buzzer must have the same value in every translation
+ * unit, Buzzer.cpp included. Set them here, or as compiler flags for the whole build
+ * (e.g. build_flags in PlatformIO); a #define in the sketch is not seen by the library's .cpp files.
+ *
+ * A mismatch is caught at link time: Buzzer::init() takes a defaulted ::BuzzerBuildConfig
+ * argument naming the options, so a sketch built with other values fails with
+ * "undefined reference to Buzzer::init(BuzzerBuildConfig<...>)".
+ */
+
+/** Scheduler counters in Buzzer (see BuzzerStats.h). */
+#if !defined(BUZZER_ENABLE_STATS)
+  #define BUZZER_ENABLE_STATS 0
+#endif
+
+/** Lateness (µs, either timebase) above which a serviced transition counts as a deadline miss. */
+#if !defined(BUZZER_STATS_MISS_US)
+  #define BUZZER_STATS_MISS_US 2000
+#endif
+
+/** Edge trace ring in Buzzer (see BuzzerTrace.h). */
+#if !defined(BUZZER_ENABLE_TRACE)
+  #define BUZZER_ENABLE_TRACE 0
+#endif
+
+/** Entries of the trace ring (power of two, 2 bytes each). */
+#if !defined(BUZZER_TRACE_SIZE)
+  #define BUZZER_TRACE_SIZE 64
+#endif
+
+/**
+ * @struct BuzzerBuildConfig
+ * @brief Empty tag whose type names the layout options (see the file comment).
+ */
+template <int STATS, int TRACE, long TRACE_SIZE>
+struct BuzzerBuildConfig {};
+
+/** @brief The options of this translation unit (the trace size only matters with the trace on). */
+typedef BuzzerBuildConfig<BUZZER_ENABLE_STATS, BUZZER_ENABLE_TRACE,
+                          BUZZER_ENABLE_TRACE ? (long)BUZZER_TRACE_SIZE : 0L> BuzzerBuildCheck;
@@ -0,0 +1,274 @@
+#include "BuzzerEngine.h"
+#include "BuzzerPattern.h"
+
+// ------------------------------ Built-in step tables ------------------------------
+// Generated from ::BuzzerPresetPattern (BuzzerPattern.h), which also gives presetDurationMs().
+namespace {
+using namespace BuzzerPresetPattern;
+
+// Indexed by BuzzerPreset.
+const uint16_t* const kPresetTables[] PROGMEM = {
+  table<Init>(), table<Stop>(), table<Warning1>(), table<Warning2>(), table<Warning3>(),
+  table<Heartbeat>(), table<ErrorAlert>(), table<Success>(), table<Alarm>(), table<MorseSOS>()
+};
+
+// Morse code of one character: elements from the LSB up (1 = dah), below a leading 1 that marks
+// the end (e.g. A ".-" = 0b110). 0 = not keyable.
+constexpr uint8_t mc(const char* s) { return *s == 0 ? 1 : (uint8_t)((mc(s + 1) << 1) | (*s == '-')); }
+
+// Indexed by character - '!' ('!'..'Z'; lowercase is folded to uppercase).
+const uint8_t kMorseCodes[] PROGMEM = {
+  mc("-.-.--"), mc(".-..-."), 0, mc("...-..-"), 0, mc(".-..."), mc(".----."),   // ! " # $ % & '
+  mc("-.--."), mc("-.--.-"), 0, mc(".-.-."), mc("--..--"), mc("-....-"),       // ( ) * + , -
+  mc(".-.-.-"), mc("-..-."),                                                   // . /
+  mc("-----"), mc(".----"), mc("..---"), mc("...--"), mc("....-"),             // 0..4
+  mc("....."), mc("-...."), mc("--..."), mc("---.."), mc("----."),             // 5..9
+  mc("---..."), mc("-.-.-."), 0, mc("-...-"), 0, mc("..--.."), mc(".--.-."),   // : ; < = > ? @
+  mc(".-"),   mc("-..."), mc("-.-."), mc("-.."),  mc("."),    mc("..-."),      // A..F
+  mc("--."),  mc("...."), mc(".."),   mc(".---"), mc("-.-"),  mc(".-.."),      // G..L
+  mc("--"),   mc("-."),   mc("---"),  mc(".--."), mc("--.-"), mc(".-."),       // M..R
+  mc("..."),  mc("-"),    mc("..-"),  mc("...-"), mc(".--"),  mc("-..-"),      // S..X
+  mc("-.--"), mc("--..")                                                       // Y Z
+};
+
+uint8_t morseCode(char c) {
+  if (c >= 'a' && c <= 'z') c = (char)(c - ('a' - 'A'));
+  if (c < '!' || c > 'Z') return 0;
+  return pgm_read_byte(&kMorseCodes[c - '!']);
+}
+
+char textAt(const char* p, bool inFlash) { return inFlash ? (char)pgm_read_byte(p) : *p; }
+
+// Upper bound of control words (loop/end) executed before a timed step; guards malformed tables.
+constexpr uint8_t kMaxControlWords = 8;
+
+// Upper bound of steps skipped by one advance() under BuzzerCatchUp::Skip; the next call resumes.
+constexpr uint8_t kMaxSkipSteps = 255;
+} // namespace
+
+const uint16_t* BuzzerEngine::presetTable(BuzzerPreset preset) {
+  const uint8_t idx = static_cast<uint8_t>(preset);
+  if (idx >= sizeof(kPresetTables) / sizeof(kPresetTables[0])) return nullptr;
+  return static_cast<const uint16_t*>(pgm_read_ptr(&kPresetTables[idx]));
+}
+
+// ------------------------------ Commands ------------------------------
+void BuzzerEngine::startBlink(uint16_t on_ms, uint16_t off_ms, uint32_t repeat, unsigned long now) {
+  _unitUs = false;
+  _startBlink(_ticks(on_ms), _ticks(off_ms), repeat, now);
+}
+
+void BuzzerEngine::startBlinkUs(uint32_t on_us, uint32_t off_us, uint32_t repeat, unsigned long now) {
+  _unitUs = true;
+  _startBlink(_ticks(on_us), _ticks(off_us), repeat, now);
+}
+
+void BuzzerEngine::_startBlink(uint32_t on_ticks, uint32_t off_ticks, uint32_t repeat, unsigned long now) {
+  _mode          = Mode::Blink;
+  _blinkOnTicks  = on_ticks;
+  _blinkOffTicks = off_ticks;
+  _blinkRemain   = repeat;                // 0 ⇒ infinite
+  _blinkOnPhase  = true;                  // start with ON
+  _on            = true;
+  _nextToggleMs  = now + _blinkOnTicks;
+  _lag           = 0;
+}
+
+void BuzzerEngine::playPreset(BuzzerPreset preset, uint32_t repeat, unsigned long now) {
+  playPattern(presetTable(preset), repeat, now);
+}
+
+void BuzzerEngine::playPattern(const uint16_t* steps, uint32_t repeat, unsigned long now) {
+  _unitUs = false;
+  _startPattern(steps, repeat, now);
+}
+
+void BuzzerEngine::playPatternUs(const uint16_t* steps, uint32_t repeat, unsigned long now) {
+  _unitUs = true;
+  _startPattern(steps, repeat, now);
+}
+
+void BuzzerEngine::_startPattern(const uint16_t* steps, uint32_t repeat, unsigned long now) {
+  if (steps == nullptr) return;
+
+  _mode = Mode::Pattern;
+  _pattern = steps;
+  _presetRepeatRemain = repeat; // 0 ⇒ infinite
+  _step = _sub = _burst = 0;
+
+  // Kick off first step immediately; later steps are scheduled from this anchor
+  _nextToggleMs = now;
+  _lag = 0;
+  if (!_nextStep()) stop();
+}
+
+void BuzzerEngine::playMorse(const char* text, bool inFlash, uint8_t wpm, uint32_t repeat, unsigned long now) {
+  // Text that would never key anything (the interpreter would spin looking for it) plays
+  // nothing: like an empty pattern, it still replaces the running sound.
+  if (text == nullptr) { stop(); return; }
+  const char* p = text;
+  while (textAt(p, inFlash) != 0 && morseCode(textAt(p, inFlash)) == 0) ++p;
+  if (textAt(p, inFlash) == 0) { stop(); return; }
+
+  _mode = Mode::Morse;
+  _textFlash = inFlash;
+  _unitUs = true;
+  _morseUnit = _ticks(1200000UL / (wpm ? wpm : 1));
+  _text = _textPos = text;
+  _morseBits = 0;
+  _presetRepeatRemain = repeat; // 0 ⇒ infinite
+
+  _nextToggleMs = now;
+  _lag = 0;
+  if (!_nextMorse()) stop();
+}
+
+void BuzzerEngine::apply(const BuzzerCommand& cmd, unsigned long now) {
+  switch (cmd.type) {
+    case BuzzerCommand::Type::StartBlink:  startBlink(cmd.onMs, cmd.offMs, cmd.repeat, now); break;
+    case BuzzerCommand::Type::PlayPreset:  playPreset(cmd.preset, cmd.repeat, now);           break;
+    case BuzzerCommand::Type::PlayPattern: playPattern(cmd.pattern, cmd.repeat, now);         break;
+    case BuzzerCommand::Type::Stop:        stop();                                            break;
+  }
+}
+
+// ------------------------------ Step-table interpreter ------------------------------
+// Execute control words up to the next timed step, apply its level and schedule it
+// relative to the previous deadline. Returns false once the last pass has ended.
+bool BuzzerEngine::_nextStep() {
+  for (uint8_t guard = 0; guard < kMaxControlWords; ++guard) {
+    const uint16_t w = pgm_read_word(&_pattern[_step]);
+    switch (w & BuzzerStep::OP_MASK) {
+      case BuzzerStep::OP_TONE:
+        _on = true;
+        _nextToggleMs += _ticks(w & BuzzerStep::ARG_MASK);
+        _step++;
+        return true;
+
+      case BuzzerStep::OP_GAP:
+        _on = false;
+        _nextToggleMs += _ticks(w & BuzzerStep::ARG_MASK);
+        _step++;
+        return true;
+
+      case BuzzerStep::OP_LOOP: {
+        uint8_t& counter = (w & BuzzerStep::LOOP_DEPTH_BIT) ? _burst : _sub;
+        if (++counter < (uint8_t)(w & 0xFF)) {
+          _step -= (w >> 8) & 0x1F;
+        } else {
+          counter = 0;
+          _step++;
+        }
+      } break;
+
+      default: // OP_END: one pass done
+        if (_step == 0) return false;   // empty table
+        if (_presetRepeatRemain == 1) return false;
+        if (_presetRepeatRemain > 1)  _presetRepeatRemain--;
+        _passes++;
+        _step = _sub = _burst = 0;
+        break;
+    }
+  }
+  return false;
+}
+
+// ------------------------------ Morse interpreter ------------------------------
+// One element or gap per call, encoded from the text on the fly. A dot is 1 unit, a dash 3;
+// gaps are 1 unit inside a character, 3 between characters and 7 between words and passes.
+bool BuzzerEngine::_nextMorse() {
+  if (_on) {                                   // element done: inter-element gap
+    _on = false;
+    _nextToggleMs += _morseUnit;
+    return true;
+  }
+
+  uint8_t extra = (_morseBits == 1) ? 2 : 0;   // a character just ended: letter gap
+  while (_morseBits <= 1) {
+    const char c = textAt(_textPos, _textFlash);
+    if (c == 0) {                              // end of one pass
+      if (_presetRepeatRemain == 1) return false;
+      if (_presetRepeatRemain > 1)  _presetRepeatRemain--;
+      _passes++;
+      _textPos = _text;
+      extra = 6;
+      continue;
+    }
+    ++_textPos;
+    if (c == ' ') { if (extra) extra = 6; continue; }
+    _morseBits = morseCode(c);
+  }
+
+  if (extra) {                                 // stay OFF: no edge, the owner sees no change
+    _nextToggleMs += extra * _morseUnit;
+    return true;
+  }
+
+  _on = true;
+  _nextToggleMs += (_morseBits & 1) ? 3 * _morseUnit : _morseUnit;
+  _morseBits >>= 1;
+  return true;
+}
+
+// ------------------------------ Scheduler ------------------------------
+// One transition, scheduled from the previous deadline (no drift from late calls).
+void BuzzerEngine::_transition() {
+  switch (_mode) {
+    // -------- BLINK ENGINE --------
+    case Mode::Blink: {
+      if (_blinkOnPhase) {
+        // ON -> OFF
+        _on = false;
+        _blinkOnPhase = false;
+        _nextToggleMs += _blinkOffTicks;
+      } else {
+        // OFF -> next ON or stop if finite done
+        if (_blinkRemain == 1) { stop(); return; }
+        if (_blinkRemain > 1) _blinkRemain--; // (0 means infinite)
+        _passes++;
+        _on = true;
+        _blinkOnPhase = true;
+        _nextToggleMs += _blinkOnTicks;
+      }
+    } break;
+
+    // -------- PRESET / PATTERN ENGINE --------
+    case Mode::Pattern: {
+      if (!_nextStep()) stop();
+    } break;
+
+    // -------- MORSE TEXT --------
+    case Mode::Morse: {
+      if (!_nextMorse()) stop();
+    } break;
+
+    case Mode::Idle: default: break;
+  }
+}
+
+void BuzzerEngine::advance(unsigned long now) {
+  switch (_catchUp) {
+    case BuzzerCatchUp::Strict:
+      _transition();
+      break;
+
+    case BuzzerCatchUp::Skip: {
+      // Fast-forward through missed steps; only the level of the step containing `now` survives.
+      uint8_t n = 0;
+      do { _transition(); } while (++n < kMaxSkipSteps && isDue(now));
+    } break;
+
+    case BuzzerCatchUp::Compress: {
+      // Steps follow the nominal (on-time) schedule; only the live deadline is pushed back.
+      _nextToggleMs -= _lag;
+      const unsigned long prev = _nextToggleMs;
+      _transition();
+      if (_mode == Mode::Idle) { _lag = 0; break; }
+      // The late step ends on its nominal deadline if at least half of it is left, else after
+      // half of it; the lag it cannot absorb is carried to the following steps.
+      const unsigned long minEnd = now + (_nextToggleMs - prev + 1) / 2;
+      _lag = (long)(minEnd - _nextToggleMs) > 0 ? minEnd - _nextToggleMs : 0;
+      _nextToggleMs += _lag;
+    } break;
+  }
+}
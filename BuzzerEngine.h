@@ -0,0 +1,292 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file BuzzerEngine.h
+ * @brief Pin-agnostic timing engine shared by Buzzer and StaticBuzzer.
+ *
+ * The engine holds the blink, step-table and Morse state machines and a software ON/OFF level.
+ * It never touches a pin: its owner advances it and writes the pin when isOn() changes.
+ */
+
+/** @enum BuzzerPreset
+ *  @brief BuzzerPreset audible patterns (each one is a built-in ::BuzzerStep table).
+ */
+enum class BuzzerPreset : uint8_t {
+  Init = 0,    ///< 1s ON, 0.1s OFF
+  Stop,        ///< Two short beeps: 2×(100ms ON, 100ms OFF)
+  Warning1,    ///< 10 bursts; each burst: 20×(5ms ON, 5ms OFF) then 200ms pause
+  Warning2,    ///< 100ms ON, 100ms OFF
+  Warning3,    ///< 10×(25ms ON, 25ms OFF)
+
+  Heartbeat,   ///< Short pip every ~1s: ON 50ms, OFF 950ms (repeatable)
+  ErrorAlert,  ///< Triple: (ON 200ms, OFF 100ms)×3, then 1s pause
+  Success,     ///< Confirmation: ON 100ms, OFF 50ms, ON 400ms, then 200ms OFF between repeats
+  Alarm,       ///< Long ON siren-like: ON 2000ms, OFF 200ms (repeatable)
+  MorseSOS     ///< SOS in Morse (· · · — — — · · ·), 100ms unit timing
+};
+
+/**
+ * @namespace BuzzerStep
+ * @brief Encoding of one 16-bit word of a pattern step table.
+ *
+ * Bits 15..14 hold the opcode, bits 13..0 its argument:
+ * - tone(ms) : drive ON for ms (1..16383)
+ * - gap(ms)  : drive OFF for ms (1..16383)
+ * - loop(count, back, depth) : jump back `back` words until the body ran `count` times.
+ *   Two nesting levels are available (depth 0 = inner, depth 1 = outer).
+ * - end()    : end of one pass; the engine then repeats or stops.
+ *
+ * Tables are stored in flash and must be terminated with end():
+ * @code
+ * static const uint16_t kChirp[] PROGMEM = {
+ *   BuzzerStep::tone(20), BuzzerStep::gap(30), BuzzerStep::loop(4, 2),
+ *   BuzzerStep::gap(500), BuzzerStep::end()
+ * };
+ * bz.playPattern(kChirp, 0); // infinite
+ * @endcode
+ */
+namespace BuzzerStep {
+  static constexpr uint16_t OP_MASK   = 0xC000; ///< Opcode bits
+  static constexpr uint16_t ARG_MASK  = 0x3FFF; ///< Argument bits
+  static constexpr uint16_t OP_GAP    = 0x0000; ///< OFF for ARG ms
+  static constexpr uint16_t OP_TONE   = 0x4000; ///< ON for ARG ms
+  static constexpr uint16_t OP_LOOP   = 0x8000; ///< [13]=depth, [12..8]=back, [7..0]=count
+  static constexpr uint16_t OP_END    = 0xC000; ///< End of one pass
+  static constexpr uint16_t LOOP_DEPTH_BIT = 0x2000;
+
+  /** @brief ON step of @p ms milliseconds. */
+  constexpr uint16_t tone(uint16_t ms) { return OP_TONE | (ms & ARG_MASK); }
+  /** @brief OFF step of @p ms milliseconds. */
+  constexpr uint16_t gap(uint16_t ms)  { return OP_GAP  | (ms & ARG_MASK); }
+  /**
+   * @brief Loop marker: repeat the previous @p back words until they ran @p count times.
+   * @param count Total number of passes of the body (1..255)
+   * @param back  Body length in words (1..31)
+   * @param depth 0 for the inner loop, 1 for an enclosing loop
+   */
+  constexpr uint16_t loop(uint8_t count, uint8_t back, uint8_t depth = 0) {
+    return OP_LOOP | (depth ? LOOP_DEPTH_BIT : 0) | ((uint16_t)(back & 0x1F) << 8) | count;
+  }
+  /** @brief Terminator of a step table. */
+  constexpr uint16_t end() { return OP_END; }
+}
+
+/** @struct BuzzerCommand
+ *  @brief One queued request (non-blocking variants of the Buzzer API).
+ */
+struct BuzzerCommand {
+  enum class Type : uint8_t { StartBlink = 0, PlayPreset, PlayPattern, Stop };
+
+  Type            type    = Type::Stop;
+  BuzzerPreset    preset  = BuzzerPreset::Init; ///< PlayPreset
+  uint16_t        onMs    = 0;                  ///< StartBlink
+  uint16_t        offMs   = 0;                  ///< StartBlink
+  uint32_t        repeat  = 0;                  ///< StartBlink/PlayPreset/PlayPattern; 0 ⇒ infinite
+  const uint16_t* pattern = nullptr;            ///< PlayPattern (PROGMEM ::BuzzerStep table)
+};
+
+/** @enum BuzzerCatchUp
+ *  @brief What the engine does when update() runs later than a deadline.
+ *
+ * Every step is scheduled from the previous deadline, never from the time update() happened
+ * to run, so occasional lateness does not accumulate. The policy only matters once the caller
+ * falls behind by more than a step. The default is Skip.
+ */
+enum class BuzzerCatchUp : uint8_t {
+  Strict = 0, ///< Replay every missed step, one per update(), back-to-back until caught up;
+              ///< never catches up if steps are shorter than the update() period
+  Skip,       ///< Drop missed steps and jump to the step that contains the current time (default)
+  Compress    ///< Play every step; a late step ends on its on-time deadline, but lasts at least
+              ///< half its length; the remaining lag shortens the next steps until it is 0
+};
+
+/** @enum BuzzerTimebase
+ *  @brief Clock the engine schedules on.
+ *
+ * In Micros mode deadlines are micros() values (wraps every ~71 min on 32-bit cores, handled by
+ * signed differences as long as a single step stays below ~35 min). Millisecond durations
+ * (presets, startBlink(), playPattern()) are scaled ×1000; µs durations are used as is.
+ * In Millis mode µs durations are rounded up to whole milliseconds.
+ */
+enum class BuzzerTimebase : uint8_t {
+  Millis = 0, ///< millis() ticks (default)
+  Micros      ///< micros() ticks, for sub-millisecond patterns
+};
+
+/**
+ * @class BuzzerEngine
+ * @brief Blink + step-table interpreter producing an ON/OFF level over time.
+ *
+ * All times are clock values of the selected ::BuzzerTimebase, supplied by the caller
+ * (now() reads the matching clock).
+ */
+class BuzzerEngine {
+public:
+  /** @brief What the engine is currently running. */
+  enum class Mode : uint8_t { Idle = 0, Blink, Pattern, Morse };
+
+  // -------------------- Commands --------------------
+  /** @brief Start a blink (@p repeat ON pulses, 0 ⇒ infinite), beginning with ON at @p now. */
+  void startBlink(uint16_t on_ms, uint16_t off_ms, uint32_t repeat, unsigned long now);
+
+  /** @brief startBlink() with durations in microseconds. */
+  void startBlinkUs(uint32_t on_us, uint32_t off_us, uint32_t repeat, unsigned long now);
+
+  /** @brief Start a built-in preset table (@p repeat passes, 0 ⇒ infinite). */
+  void playPreset(BuzzerPreset preset, uint32_t repeat, unsigned long now);
+
+  /** @brief Start a PROGMEM ::BuzzerStep table (@p repeat passes, 0 ⇒ infinite). */
+  void playPattern(const uint16_t* steps, uint32_t repeat, unsigned long now);
+
+  /** @brief playPattern() with the table's step durations read as microseconds (1..16383 µs). */
+  void playPatternUs(const uint16_t* steps, uint32_t repeat, unsigned long now);
+
+  /**
+   * @brief Key @p text in Morse code (@p repeat passes, 0 ⇒ infinite), one element per transition.
+   * @param text   NUL-terminated text, read in place (must stay valid while playing)
+   * @param inFlash true if @p text lives in PROGMEM
+   * @param wpm    Speed in PARIS words per minute (unit = 1200 / wpm ms)
+   *
+   * Letters (any case), digits and common punctuation are keyed; other characters are skipped
+   * and spaces separate words. Text without any keyable character plays nothing.
+   */
+  void playMorse(const char* text, bool inFlash, uint8_t wpm, uint32_t repeat, unsigned long now);
+
+  /** @brief Execute a queued ::BuzzerCommand. */
+  void apply(const BuzzerCommand& cmd, unsigned long now);
+
+  /** @brief Stop whatever runs and go OFF. */
+  void stop() { _mode = Mode::Idle; _on = false; }
+
+  /** @brief Force the level (direct on()/off()); a running sound overrides it at its next edge. */
+  void setOn(bool on) { _on = on; }
+
+  /** @brief Return to idle/OFF, keeping the configuration (catch-up policy, timebase). */
+  void reset() {
+    const BuzzerCatchUp catchUp = _catchUp;
+    const BuzzerTimebase timebase = _timebase;
+    *this = BuzzerEngine();
+    _catchUp = catchUp;
+    _timebase = timebase;
+  }
+
+  // -------------------- Configuration --------------------
+  /**
+   * @brief Select the late-update policy (default ::BuzzerCatchUp::Skip).
+   *
+   * Skip keeps the schedule and the level right after any stall, at the cost of the steps it
+   * drops. Compress plays every step and closes the lag over the following steps, shortening
+   * none below half. Strict plays every step at full length but its lag is unbounded: with steps
+   * shorter than the update() period (e.g. Warning1's 5 ms at a 20 ms loop) the sound falls
+   * behind for good and outlasts its nominal end.
+   */
+  void setCatchUp(BuzzerCatchUp policy) {
+    _nextToggleMs -= _lag;   // other policies run on the on-time schedule
+    _lag = 0;
+    _catchUp = policy;
+  }
+  BuzzerCatchUp catchUp() const { return _catchUp; }
+
+  /** @brief Select the scheduling clock; stops a running sound (its deadline would be meaningless). */
+  void setTimebase(BuzzerTimebase timebase) {
+    if (timebase != _timebase) { stop(); _timebase = timebase; }
+  }
+  BuzzerTimebase timebase() const { return _timebase; }
+
+  /** @brief Current value of the timebase clock (millis() or micros()). */
+  unsigned long now() const {
+    return _timebase == BuzzerTimebase::Micros ? micros() : millis();
+  }
+
+  // -------------------- State --------------------
+  Mode mode() const { return _mode; }
+  bool isBusy() const { return _mode != Mode::Idle; }
+  bool isOn() const { return _on; }
+
+  /**
+   * @brief Count of repeat boundaries crossed (pass of a table or Morse text, blink pulse), mod 256.
+   * @note Only differences matter: compare values taken before and after advance().
+   */
+  uint8_t passes() const { return _passes; }
+
+  /** @brief Clock value of the next scheduled transition (meaningful while busy). */
+  unsigned long deadline() const { return _nextToggleMs; }
+
+  /**
+   * @brief Re-anchor a saved copy of the engine: its current step ends @p remain ticks after @p now.
+   * @note Pair with timeUntilNext() taken when the copy was saved (see BuzzerRequestQueue).
+   */
+  void rebase(unsigned long remain, unsigned long now) { _nextToggleMs = now + remain; _lag = 0; }
+
+  /** @brief Value returned by timeUntilNext() when nothing is scheduled. */
+  static constexpr unsigned long IDLE_FOREVER = (unsigned long)-1;
+
+  /**
+   * @brief Clock ticks from @p now until the next transition.
+   * @return 0 if already due, IDLE_FOREVER if idle
+   */
+  unsigned long timeUntilNext(unsigned long now) const {
+    if (_mode == Mode::Idle) return IDLE_FOREVER;
+    const long d = (long)(_nextToggleMs - now);
+    return d > 0 ? (unsigned long)d : 0;
+  }
+
+  /** @brief Whether a transition is due at @p now. */
+  bool isDue(unsigned long now) const {
+    return _mode != Mode::Idle && (long)(now - _nextToggleMs) >= 0;
+  }
+
+  // -------------------- Scheduler --------------------
+  /**
+   * @brief Perform the transition(s) due at @p now (call only when isDue(now)).
+   * @note Under ::BuzzerCatchUp::Strict the engine may still be due afterwards.
+   */
+  void advance(unsigned long now);
+
+  /** @brief Built-in table of @p preset, or nullptr if out of range. */
+  static const uint16_t* presetTable(BuzzerPreset preset);
+
+private:
+  bool _nextStep();
+  bool _nextMorse();
+  void _transition();
+  void _startPattern(const uint16_t* steps, uint32_t repeat, unsigned long now);
+  void _startBlink(uint32_t on_ticks, uint32_t off_ticks, uint32_t repeat, unsigned long now);
+
+  /** @brief Convert a duration in the current sound's unit (ms, or µs when _unitUs) to clock ticks. */
+  inline uint32_t _ticks(uint32_t v) const {
+    if (_timebase == BuzzerTimebase::Micros) return _unitUs ? v : v * 1000UL;
+    return _unitUs ? (v + 999UL) / 1000UL : v;
+  }
+
+  Mode           _mode = Mode::Idle;
+  BuzzerCatchUp  _catchUp = BuzzerCatchUp::Skip;
+  BuzzerTimebase _timebase = BuzzerTimebase::Millis;
+  bool           _unitUs = false;   ///< durations of the running sound are in µs
+  bool           _on   = false;
+  unsigned long  _nextToggleMs = 0; ///< next deadline, in ticks of _timebase
+  unsigned long  _lag = 0;          ///< Compress: ticks _nextToggleMs runs behind the on-time schedule
+  uint8_t        _passes = 0;       ///< repeat boundaries crossed, see passes()
+
+  // ---- blink state ----
+  bool           _blinkOnPhase = false;
+  uint32_t       _blinkOnTicks = 0;
+  uint32_t       _blinkOffTicks = 0;
+  uint32_t       _blinkRemain = 0;     ///< Remaining ON pulses; 0 ⇒ infinite
+
+  // ---- step-table state (presets and custom patterns) ----
+  const uint16_t* _pattern = nullptr;      ///< PROGMEM ::BuzzerStep table being played
+  uint32_t       _presetRepeatRemain = 0;  ///< Remaining passes; 0 ⇒ infinite
+
+  uint8_t        _step = 0;     ///< index of the next word in _pattern
+  uint8_t        _sub  = 0;     ///< inner loop counter (depth 0)
+  uint8_t        _burst= 0;     ///< outer loop counter (depth 1)
+
+  // ---- Morse state (repeat count shared with the step tables) ----
+  const char*    _text = nullptr;      ///< start of the text being keyed
+  const char*    _textPos = nullptr;   ///< next character to encode
+  bool           _textFlash = false;   ///< _text is in PROGMEM
+  uint8_t        _morseBits = 0;       ///< elements left in the current character, see kMorseCodes
+  uint32_t       _morseUnit = 0;       ///< dot length in ticks
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @file BuzzerGpio.h
+ * @brief Output policies used by Buzzer to drive its pin.
+ *
+ * A policy resolves the pin once in attach() and then writes levels with write().
+ * - BuzzerPinGpio  : plain digitalWrite(); works on every core.
+ * - BuzzerPortGpio : cached output register + bit mask; one read-modify-write per edge.
+ * - BuzzerStaticGpio<PIN> : pin fixed at compile time, no RAM; a single sbi/cbi on ATmega328P/168.
+ *
+ * ::BuzzerDefaultGpio picks the port policy on AVR and digitalWrite() elsewhere. Define
+ * BUZZER_GPIO_DIGITALWRITE to force the portable path on AVR. The port policy is AVR only:
+ * it keeps 8-bit registers and masks and guards the read-modify-write with SREG/cli(), while
+ * SAMD, ESP32 or RP2040 cores have 32-bit registers and need another atomic write. Defining
+ * BUZZER_GPIO_PORT to 1 on such a core is an error. (The host mock in extras/host emulates
+ * 8-bit ports and sets BUZZER_GPIO_PORT_HOST to allow it.)
+ */
+
+#if !defined(BUZZER_GPIO_PORT)
+  #if defined(__AVR__) && !defined(BUZZER_GPIO_DIGITALWRITE)
+    #define BUZZER_GPIO_PORT 1
+  #else
+    #define BUZZER_GPIO_PORT 0
+  #endif
+#endif
+
+#if BUZZER_GPIO_PORT && !defined(__AVR__) && !defined(BUZZER_GPIO_PORT_HOST)
+  #error "BUZZER_GPIO_PORT=1 is AVR only (8-bit port registers, SREG guard); use the default on this core"
+#endif
+
+/** @class BuzzerPinGpio
+ *  @brief Portable policy: one digitalWrite() per edge.
+ */
+class BuzzerPinGpio {
+public:
+  /** @brief Remember @p pin. @return true (every pin number is accepted). */
+  bool attach(uint8_t pin) { _pin = pin; return true; }
+
+  /** @brief Drive the pin to @p level (HIGH/LOW). */
+  inline void write(uint8_t level) const { digitalWrite(_pin, level); }
+
+private:
+  uint8_t _pin = 0;
+};
+
+#if BUZZER_GPIO_PORT
+/** @class BuzzerPortGpio
+ *  @brief Fast policy: output register and bit mask resolved once, single register update per edge.
+ */
+class BuzzerPortGpio {
+public:
+  /**
+   * @brief Resolve the port register and bit mask of @p pin.
+   * @return false if the core reports @p pin as not a digital pin.
+   */
+  bool attach(uint8_t pin) {
+    const uint8_t port = digitalPinToPort(pin);
+    if (port == NOT_A_PIN) { _out = nullptr; return false; }
+    _out  = portOutputRegister(port);
+    _mask = digitalPinToBitMask(pin);
+    return true;
+  }
+
+  /** @brief Drive the pin to @p level (HIGH/LOW). */
+  inline void write(uint8_t level) const {
+#if defined(__AVR__)
+    // The port may be shared with pins written from interrupts: keep the RMW atomic.
+    const uint8_t sreg = SREG;
+    cli();
+#endif
+    if (level) *_out |= _mask;
+    else       *_out &= (uint8_t)~_mask;
+#if defined(__AVR__)
+    SREG = sreg;
+#endif
+  }
+
+private:
+  volatile uint8_t* _out = nullptr;
+  uint8_t           _mask = 0;
+};
+
+using BuzzerDefaultGpio = BuzzerPortGpio;
+#else
+using BuzzerDefaultGpio = BuzzerPinGpio;
+#endif
+
+/** @class BuzzerStaticGpio
+ *  @brief Compile-time policy: the pin is a template constant, nothing is stored.
+ *
+ * On ATmega328P/168 boards (Uno, Nano, Pro Mini) the port and bit are folded at compile time,
+ * so write() becomes a single sbi/cbi instruction (atomic, no interrupt masking needed).
+ * Other targets fall back to digitalWrite() with a constant pin.
+ */
+template <uint8_t PIN>
+class BuzzerStaticGpio {
+public:
+  /** @brief Drive the pin to @p level (HIGH/LOW). */
+  static inline void write(uint8_t level) {
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__)
+    // Uno pin map: D0..D7 = PORTD0..7, D8..D13 = PORTB0..5, D14..D19 (A0..A5) = PORTC0..5
+    if (PIN < 8) {
+      if (level) PORTD |= _BV(PIN & 7);        else PORTD &= (uint8_t)~_BV(PIN & 7);
+    } else if (PIN < 14) {
+      if (level) PORTB |= _BV((PIN - 8) & 7);  else PORTB &= (uint8_t)~_BV((PIN - 8) & 7);
+    } else {
+      if (level) PORTC |= _BV((PIN - 14) & 7); else PORTC &= (uint8_t)~_BV((PIN - 14) & 7);
+    }
+#else
+    digitalWrite(PIN, level);
+#endif
+  }
+};
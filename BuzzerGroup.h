@@ -0,0 +1,158 @@
+#pragma once
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerGroup.h
+ * @brief Scheduler for many Buzzer instances: one clock read and a deadline min-heap per update().
+ *
+ * - Members are referenced, not owned; they must outlive the group.
+ * - Only busy members sit in the heap, ordered by their next edge deadline.
+ * - update() costs O(1) when nothing is due and O(log N) per serviced edge.
+ * - All members must use the same ::BuzzerTimebase; the group reads that clock once per update().
+ *
+ * Starting a sound on a member (startBlink(), playPreset(), playPattern(), stopXxx())
+ * changes its deadline behind the group's back: call refresh() on it afterwards.
+ *
+ * @code
+ * Buzzer a, b;
+ * BuzzerGroup<12> group;
+ * group.add(a); group.add(b);
+ *
+ * a.playPreset(BuzzerPreset::Heartbeat, true, 0); group.refresh(a);
+ * b.startBlink(100, 900, 0);                      group.refresh(b);
+ *
+ * void loop() {
+ *   group.update(); // instead of a.update(); b.update(); ...
+ * }
+ * @endcode
+ */
+template <uint8_t CAPACITY>
+class BuzzerGroup {
+  static_assert(CAPACITY > 0 && CAPACITY < 255, "BuzzerGroup: CAPACITY must be 1..254");
+
+public:
+  BuzzerGroup() = default;
+
+  /**
+   * @brief Register a buzzer; it is scheduled immediately if already busy.
+   * @return false if the group is full or @p bz is already a member.
+   */
+  bool add(Buzzer& bz) {
+    if (_count >= CAPACITY || _indexOf(bz) >= 0) return false;
+    _members[_count++] = &bz;
+    refresh(bz);
+    return true;
+  }
+
+  /** @brief Unregister a buzzer (its sound keeps its state but is no longer serviced). */
+  bool remove(Buzzer& bz) {
+    const int i = _indexOf(bz);
+    if (i < 0) return false;
+    _heapErase(bz);
+    _members[i] = _members[--_count];
+    return true;
+  }
+
+  /**
+   * @brief Re-read a member's deadline after it was commanded directly.
+   * @note O(N) search plus O(log N) heap fix-up; not meant for the hot path.
+   */
+  void refresh(Buzzer& bz) {
+    if (_indexOf(bz) < 0) return;
+    _heapErase(bz);
+    if (bz.isBusy()) _heapPush(&bz);
+  }
+
+  /** @brief Service every member whose deadline has passed, using a single clock read. */
+  void update() {
+    if (_heapSize == 0) return;
+    const unsigned long now = _heap[0]->_engine.now();
+
+    // Each serviced member leaves or moves down the heap. Bound the pass by the number of
+    // scheduled members so that zero-length steps or a Strict catch-up cannot keep one call spinning.
+    const uint8_t budget = _heapSize;
+    for (uint8_t n = 0; n < budget && _heapSize > 0; ++n) {
+      Buzzer* top = _heap[0];
+      if (!top->_engine.isDue(now)) return;
+
+      top->update(now);
+      if (top->isBusy()) _siftDown(0);
+      else               _heapRemoveAt(0);
+    }
+  }
+
+  /**
+   * @brief Milliseconds until the earliest member edge (0 if due, Buzzer::IDLE_FOREVER if none).
+   * @note O(1): reads the heap top only.
+   */
+  unsigned long msUntilNextEvent() const {
+    if (_heapSize == 0) return Buzzer::IDLE_FOREVER;
+    return _heap[0]->msUntilNextEvent();
+  }
+
+  /** @brief Stop every member and empty the schedule. */
+  void stopAll() {
+    for (uint8_t i = 0; i < _count; ++i) _members[i]->stopAll();
+    _heapSize = 0;
+  }
+
+  /** @brief Number of registered buzzers. */
+  uint8_t size() const { return _count; }
+
+  /** @brief Number of members currently scheduled (busy). */
+  uint8_t activeCount() const { return _heapSize; }
+
+private:
+  Buzzer* _members[CAPACITY] = {};
+  Buzzer* _heap[CAPACITY] = {};
+  uint8_t _count = 0;
+  uint8_t _heapSize = 0;
+
+  static bool _before(const Buzzer* a, const Buzzer* b) {
+    return (long)(a->_engine.deadline() - b->_engine.deadline()) < 0;
+  }
+
+  int _indexOf(const Buzzer& bz) const {
+    for (uint8_t i = 0; i < _count; ++i) if (_members[i] == &bz) return i;
+    return -1;
+  }
+
+  void _heapPush(Buzzer* bz) {
+    uint8_t i = _heapSize++;
+    _heap[i] = bz;
+    _siftUp(i);
+  }
+
+  void _heapErase(const Buzzer& bz) {
+    for (uint8_t i = 0; i < _heapSize; ++i) {
+      if (_heap[i] == &bz) { _heapRemoveAt(i); return; }
+    }
+  }
+
+  void _heapRemoveAt(uint8_t i) {
+    _heap[i] = _heap[--_heapSize];
+    if (i < _heapSize) { _siftDown(i); _siftUp(i); }
+  }
+
+  void _siftUp(uint8_t i) {
+    while (i > 0) {
+      const uint8_t parent = (uint8_t)((i - 1) / 2);
+      if (!_before(_heap[i], _heap[parent])) break;
+      Buzzer* t = _heap[i]; _heap[i] = _heap[parent]; _heap[parent] = t;
+      i = parent;
+    }
+  }
+
+  void _siftDown(uint8_t i) {
+    for (;;) {
+      const uint16_t l = 2u * i + 1u;
+      const uint16_t r = l + 1u;
+      uint8_t best = i;
+      if (l < _heapSize && _before(_heap[l], _heap[best])) best = (uint8_t)l;
+      if (r < _heapSize && _before(_heap[r], _heap[best])) best = (uint8_t)r;
+      if (best == i) return;
+      Buzzer* t = _heap[i]; _heap[i] = _heap[best]; _heap[best] = t;
+      i = best;
+    }
+  }
+};
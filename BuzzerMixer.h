@@ -0,0 +1,209 @@
+#pragma once
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerMixer.h
+ * @brief Several sounds at once on one Buzzer: independent layers combined into one output.
+ *
+ * Each layer is a full ::BuzzerEngine (blink, preset, pattern or Morse) with its own deadline.
+ * After every layer change the output is their combination (::BuzzerMix):
+ * - Or       : ON while any layer is ON, e.g. a Heartbeat pip over a slow status blink
+ * - Xor      : ON while an odd number of layers is ON (a layer's ON punches a gap into another)
+ * - Priority : the highest busy layer alone decides, ON or OFF; lower layers show through
+ *              once it finishes
+ *
+ * update() costs O(1) until the earliest layer deadline (cached), then advances the due layers
+ * and writes the pin only if the combined level changed. msUntilNextEvent() gives that earliest
+ * deadline for sleeping loops.
+ *
+ * Layers take the buzzer's timebase and catch-up policy when a sound starts on them. While the
+ * mixer owns a buzzer, command it only through the mixer and call the mixer's update() instead
+ * of the buzzer's.
+ *
+ * @code
+ * Buzzer bz;
+ * BuzzerMixer<2> mix(bz);               // BuzzerMix::Or
+ *
+ * void setup() {
+ *   bz.init();
+ *   mix.startBlink(0, 500, 4500);                      // layer 0: slow status cadence
+ *   mix.playPreset(1, BuzzerPreset::Heartbeat, 0);     // layer 1: pip every second
+ * }
+ * void loop() { mix.update(); }
+ * @endcode
+ */
+
+/** @enum BuzzerMix
+ *  @brief How BuzzerMixer combines its layers.
+ */
+enum class BuzzerMix : uint8_t {
+  Or = 0,   ///< ON if any layer is ON
+  Xor,      ///< ON if an odd number of layers is ON
+  Priority  ///< Level of the highest-numbered busy layer
+};
+
+template <uint8_t LAYERS>
+class BuzzerMixer {
+  static_assert(LAYERS > 0 && LAYERS <= 8, "BuzzerMixer: LAYERS must be 1..8");
+
+public:
+  /** @brief Mix sounds onto @p bz (referenced, must outlive the mixer). */
+  explicit BuzzerMixer(Buzzer& bz, BuzzerMix mix = BuzzerMix::Or) : _bz(bz), _mix(mix) {}
+
+  /** @brief Change the combination rule; the output follows at once. */
+  void setMix(BuzzerMix mix) {
+    _mix = mix;
+    _output();
+  }
+
+  BuzzerMix mix() const { return _mix; }
+
+  // -------------------- Layer commands --------------------
+  /**
+   * @brief Run a StartBlink, PlayPreset or PlayPattern command on @p layer, replacing its sound.
+   * @return false if @p bz is not initialized, @p layer is out of range or the command plays
+   *         nothing. A Stop command stops the layer.
+   */
+  bool request(uint8_t layer, const BuzzerCommand& cmd) {
+    BuzzerEngine* eng = _claim(layer);
+    if (eng == nullptr) return false;
+    eng->apply(cmd, _bz._engine.now());
+    _changed();
+    return cmd.type == BuzzerCommand::Type::Stop || eng->isBusy();
+  }
+
+  /** @brief Buzzer::startBlink() on @p layer. */
+  bool startBlink(uint8_t layer, uint16_t on_ms, uint16_t off_ms, uint32_t repeat = 0) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::StartBlink;
+    c.onMs = on_ms; c.offMs = off_ms; c.repeat = repeat;
+    return request(layer, c);
+  }
+
+  /** @brief Non-blocking Buzzer::playPreset() on @p layer. */
+  bool playPreset(uint8_t layer, BuzzerPreset preset, uint32_t repeat = 1) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::PlayPreset;
+    c.preset = preset; c.repeat = repeat;
+    return request(layer, c);
+  }
+
+  /** @brief Buzzer::playPattern() on @p layer. */
+  bool playPattern(uint8_t layer, const uint16_t* steps, uint32_t repeat = 1) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::PlayPattern;
+    c.pattern = steps; c.repeat = repeat;
+    return request(layer, c);
+  }
+
+  /** @brief Buzzer::playMorse() (RAM text) on @p layer. */
+  bool playMorse(uint8_t layer, const char* text, uint8_t wpm = 12, uint32_t repeat = 1) {
+    BuzzerEngine* eng = _claim(layer);
+    if (eng == nullptr) return false;
+    eng->playMorse(text, false, wpm, repeat, _bz._engine.now());
+    _changed();
+    return eng->isBusy();
+  }
+
+  /** @brief Silence @p layer; the other layers keep playing. */
+  void stop(uint8_t layer) {
+    if (layer >= LAYERS) return;
+    _layers[layer].stop();
+    _changed();
+  }
+
+  /** @brief Silence every layer and turn the buzzer OFF. */
+  void stopAll() {
+    for (uint8_t i = 0; i < LAYERS; ++i) _layers[i].stop();
+    _busy = 0;
+    _bz.stopAll();
+  }
+
+  // -------------------- Scheduler --------------------
+  /** @brief Advance the due layers and write the combined level. Call from loop(). */
+  void update() {
+    if (_busy == 0) return;
+    update(_bz._engine.now());
+  }
+
+  /** @brief update() with a caller-supplied clock value of the buzzer's timebase. */
+  void update(unsigned long now) {
+    if (_busy == 0 || (long)(now - _next) < 0) return;
+    for (uint8_t i = 0; i < LAYERS; ++i) {
+      if (_layers[i].isDue(now)) _layers[i].advance(now);
+    }
+    _changed();
+  }
+
+  /** @brief Milliseconds until the earliest layer deadline (0 if due, Buzzer::IDLE_FOREVER if idle). */
+  unsigned long msUntilNextEvent() const {
+    if (_busy == 0) return Buzzer::IDLE_FOREVER;
+    const long d = (long)(_next - _bz._engine.now());
+    const unsigned long t = d > 0 ? (unsigned long)d : 0;
+    return _bz._engine.timebase() == BuzzerTimebase::Millis ? t : t / 1000UL;
+  }
+
+  // -------------------- State --------------------
+  /** @brief Whether any layer is playing. */
+  bool isBusy() const { return _busy != 0; }
+
+  /** @brief Whether @p layer is playing. */
+  bool isBusy(uint8_t layer) const { return layer < LAYERS && _layers[layer].isBusy(); }
+
+  /** @brief Level of @p layer before mixing. */
+  bool isOn(uint8_t layer) const { return layer < LAYERS && _layers[layer].isOn(); }
+
+private:
+  Buzzer&       _bz;
+  BuzzerEngine  _layers[LAYERS];
+  BuzzerMix     _mix;
+  uint8_t       _busy = 0;      ///< bit i = layer i busy
+  unsigned long _next = 0;      ///< earliest deadline of the busy layers
+
+  // Layer @p layer configured like the buzzer, whose own sound is dropped (its pin level kept).
+  BuzzerEngine* _claim(uint8_t layer) {
+    if (!_bz.getInitFlag() || layer >= LAYERS) return nullptr;
+    BuzzerEngine& own = _bz._engine;
+    if (own.isBusy()) {
+      const bool was = own.isOn();
+      own.stop();
+      own.setOn(was);
+    }
+    BuzzerEngine& eng = _layers[layer];
+    eng.setCatchUp(own.catchUp());
+    eng.setTimebase(own.timebase());
+    return &eng;
+  }
+
+  // Recompute the busy mask and earliest deadline, then drive the combined level.
+  void _changed() {
+    _busy = 0;
+    for (uint8_t i = 0; i < LAYERS; ++i) {
+      if (!_layers[i].isBusy()) continue;
+      const unsigned long d = _layers[i].deadline();
+      if (_busy == 0 || (long)(d - _next) < 0) _next = d;
+      _busy |= (uint8_t)(1u << i);
+    }
+    _output();
+  }
+
+  void _output() {
+    bool on = false;
+    switch (_mix) {
+      case BuzzerMix::Or:
+        for (uint8_t i = 0; i < LAYERS; ++i) on = on || _layers[i].isOn();
+        break;
+      case BuzzerMix::Xor:
+        for (uint8_t i = 0; i < LAYERS; ++i) on = on != _layers[i].isOn();
+        break;
+      case BuzzerMix::Priority:
+        for (uint8_t i = LAYERS; i-- > 0; ) {
+          if (_layers[i].isBusy()) { on = _layers[i].isOn(); break; }
+        }
+        break;
+    }
+    if (!_bz.getInitFlag() || on == _bz._engine.isOn()) return;
+    _bz._engine.setOn(on);
+    _bz._write(on);
+  }
+};
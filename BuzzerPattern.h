@@ -0,0 +1,180 @@
+#pragma once
+#include "BuzzerEngine.h"
+
+/**
+ * @file BuzzerPattern.h
+ * @brief Compile-time pattern combinators that build ::BuzzerStep tables and their durations.
+ *
+ * A pattern is a type. Its step words, length and total duration are computed by the compiler,
+ * and table<P>() returns a PROGMEM table ready for playPattern(): nothing is built at run time.
+ * - tone<MS>, gap<MS>      : one ON / OFF step (1..16383)
+ * - seq<P...>              : patterns one after the other
+ * - repeat<N, P...>        : seq<P...> played N times (1..255) through a BuzzerStep::loop() word
+ * - interleave<A, B>       : steps of A and B alternately (a0 b0 a1 b1 ..., the longer one's
+ *                            remaining steps last); both must be loop-free
+ *
+ * Invalid patterns fail with a static_assert: zero or too long steps, a repeat count out of range,
+ * a repeat body over 31 words, more than two nested repeat levels, a duration over 32 bits.
+ *
+ * Every pattern P exposes:
+ * - P::duration : one pass, in the table's unit (ms for playPattern(), µs for playPatternUs())
+ * - P::size     : number of words without the terminator
+ * - P::depth    : nested repeat levels used (0..2)
+ *
+ * @code
+ * using Chirp = BuzzerPattern::seq<
+ *   BuzzerPattern::repeat<4, BuzzerPattern::tone<20>, BuzzerPattern::gap<30>>,
+ *   BuzzerPattern::gap<500>>;
+ * static_assert(Chirp::duration == 700, "");
+ * bz.playPattern(BuzzerPattern::table<Chirp>(), 0); // infinite
+ * @endcode
+ *
+ * The built-in presets are defined this way (::BuzzerPresetPattern), so presetDurationMs()
+ * is exact and usable in constant expressions.
+ */
+namespace BuzzerPattern {
+
+namespace detail {
+  template <uint16_t... W> struct Words { static constexpr uint16_t size = sizeof...(W); };
+
+  template <class A, class B> struct Cat;
+  template <uint16_t... A, uint16_t... B>
+  struct Cat<Words<A...>, Words<B...>> { using type = Words<A..., B...>; };
+
+  constexpr uint8_t maxOf(uint8_t a, uint8_t b) { return a > b ? a : b; }
+
+  template <class... P> struct Seq;
+  template <class P> struct Seq<P> {
+    using words = typename P::words;
+    static constexpr uint32_t duration = P::duration;
+    static constexpr uint8_t  depth = P::depth;
+  };
+  template <class P, class Q, class... R> struct Seq<P, Q, R...> {
+    using Rest = Seq<Q, R...>;
+    static_assert((uint64_t)P::duration + Rest::duration <= 0xFFFFFFFFull,
+                  "BuzzerPattern::seq: total duration overflows 32 bits");
+    using words = typename Cat<typename P::words, typename Rest::words>::type;
+    static constexpr uint32_t duration = P::duration + Rest::duration;
+    static constexpr uint8_t  depth = maxOf(P::depth, Rest::depth);
+  };
+
+  template <uint16_t N, class P, bool ONCE = (N == 1)> struct Repeat {
+    static_assert(P::words::size <= 31, "BuzzerPattern::repeat: body longer than 31 words");
+    static_assert(P::depth < 2, "BuzzerPattern::repeat: at most two nested repeat levels");
+    static_assert((uint64_t)N * P::duration <= 0xFFFFFFFFull,
+                  "BuzzerPattern::repeat: total duration overflows 32 bits");
+    using words = typename Cat<typename P::words,
+                               Words<BuzzerStep::loop((uint8_t)N, (uint8_t)P::words::size, P::depth)>>::type;
+    static constexpr uint32_t duration = N * P::duration;
+    static constexpr uint8_t  depth = P::depth + 1;
+  };
+  template <uint16_t N, class P> struct Repeat<N, P, true> : Seq<P> {};
+
+  template <class A, class B, class Acc = Words<>> struct Zip;
+  template <uint16_t... R> struct Zip<Words<>, Words<>, Words<R...>> { using type = Words<R...>; };
+  template <uint16_t a, uint16_t... A, uint16_t... R>
+  struct Zip<Words<a, A...>, Words<>, Words<R...>> { using type = Words<R..., a, A...>; };
+  template <uint16_t b, uint16_t... B, uint16_t... R>
+  struct Zip<Words<>, Words<b, B...>, Words<R...>> { using type = Words<R..., b, B...>; };
+  template <uint16_t a, uint16_t... A, uint16_t b, uint16_t... B, uint16_t... R>
+  struct Zip<Words<a, A...>, Words<b, B...>, Words<R...>>
+      : Zip<Words<A...>, Words<B...>, Words<R..., a, b>> {};
+
+  template <class W> struct Table;
+  template <uint16_t... W> struct Table<Words<W...>> { static const uint16_t data[sizeof...(W) + 1]; };
+  template <uint16_t... W>
+  const uint16_t Table<Words<W...>>::data[sizeof...(W) + 1] PROGMEM = { W..., BuzzerStep::OP_END };
+
+  template <uint32_t MS, uint16_t OP> struct Step {
+    static_assert(MS >= 1 && MS <= BuzzerStep::ARG_MASK, "BuzzerPattern: step duration must be 1..16383");
+    using words = Words<(uint16_t)(OP | MS)>;
+    static constexpr uint16_t size = 1;
+    static constexpr uint32_t duration = MS;
+    static constexpr uint8_t  depth = 0;
+  };
+} // namespace detail
+
+/** @brief ON for @p MS (1..16383). */
+template <uint32_t MS> struct tone : detail::Step<MS, BuzzerStep::OP_TONE> {};
+
+/** @brief OFF for @p MS (1..16383). */
+template <uint32_t MS> struct gap : detail::Step<MS, BuzzerStep::OP_GAP> {};
+
+/** @brief @p P one after the other. */
+template <class... P> struct seq : detail::Seq<P...> {
+  static_assert(sizeof...(P) > 0, "BuzzerPattern::seq: empty sequence");
+  static constexpr uint16_t size = detail::Seq<P...>::words::size;
+};
+
+/** @brief seq<P...> played @p N times (1..255). */
+template <uint16_t N, class... P> struct repeat : detail::Repeat<N, seq<P...>> {
+  static_assert(N >= 1 && N <= 255, "BuzzerPattern::repeat: count must be 1..255");
+  static constexpr uint16_t size = detail::Repeat<N, seq<P...>>::words::size;
+};
+
+/** @brief Steps of @p A and @p B alternately, e.g. an ON rhythm with an OFF rhythm. */
+template <class A, class B> struct interleave {
+  static_assert(A::depth == 0 && B::depth == 0, "BuzzerPattern::interleave: patterns must be loop-free");
+  static_assert((uint64_t)A::duration + B::duration <= 0xFFFFFFFFull,
+                "BuzzerPattern::interleave: total duration overflows 32 bits");
+  using words = typename detail::Zip<typename A::words, typename B::words>::type;
+  static constexpr uint16_t size = words::size;
+  static constexpr uint32_t duration = A::duration + B::duration;
+  static constexpr uint8_t  depth = 0;
+};
+
+/** @brief PROGMEM ::BuzzerStep table of @p P, terminated with BuzzerStep::end(). */
+template <class P>
+constexpr const uint16_t* table() { return detail::Table<typename P::words>::data; }
+
+} // namespace BuzzerPattern
+
+/**
+ * @namespace BuzzerPresetPattern
+ * @brief The built-in ::BuzzerPreset sounds (see the enum for their timing).
+ */
+namespace BuzzerPresetPattern {
+  using namespace BuzzerPattern;
+
+  using Init       = seq<tone<1000>, gap<100>>;
+  using Stop       = repeat<2, tone<100>, gap<100>>;
+  using Warning1   = repeat<10, repeat<20, tone<5>, gap<5>>, gap<200>>;
+  using Warning2   = seq<tone<100>, gap<100>>;
+  using Warning3   = repeat<10, tone<25>, gap<25>>;
+  using Heartbeat  = seq<tone<50>, gap<950>>;
+  using ErrorAlert = seq<repeat<3, tone<200>, gap<100>>, gap<1000>>;
+  using Success    = seq<tone<100>, gap<50>, tone<400>, gap<200>>;
+  using Alarm      = seq<tone<2000>, gap<200>>;
+  using MorseSOS   = seq<
+    repeat<3, tone<100>, gap<100>>, gap<200>,   // S  (· · ·) + letter gap
+    repeat<3, tone<300>, gap<100>>, gap<200>,   // O  (— — —) + letter gap
+    repeat<3, tone<100>, gap<100>>>;            // S  (· · ·)
+}
+
+namespace BuzzerPattern {
+/** @brief Duration of one pass of @p preset in ms (0 for an unknown value). */
+constexpr uint32_t presetPassMs(BuzzerPreset preset) {
+  using namespace BuzzerPresetPattern;
+  return preset == BuzzerPreset::Init       ? Init::duration
+       : preset == BuzzerPreset::Stop       ? Stop::duration
+       : preset == BuzzerPreset::Warning1   ? Warning1::duration
+       : preset == BuzzerPreset::Warning2   ? Warning2::duration
+       : preset == BuzzerPreset::Warning3   ? Warning3::duration
+       : preset == BuzzerPreset::Heartbeat  ? Heartbeat::duration
+       : preset == BuzzerPreset::ErrorAlert ? ErrorAlert::duration
+       : preset == BuzzerPreset::Success    ? Success::duration
+       : preset == BuzzerPreset::Alarm      ? Alarm::duration
+       : preset == BuzzerPreset::MorseSOS   ? MorseSOS::duration
+       : 0;
+}
+
+/**
+ * @brief How long @p preset stays busy when played @p repeat times, in ms.
+ * @return BuzzerEngine::IDLE_FOREVER for repeat == 0 (infinite) or if the product overflows.
+ */
+constexpr unsigned long presetDurationMs(BuzzerPreset preset, uint32_t repeat = 1) {
+  return (repeat == 0 || (uint64_t)presetPassMs(preset) * repeat >= BuzzerEngine::IDLE_FOREVER)
+           ? BuzzerEngine::IDLE_FOREVER
+           : (unsigned long)presetPassMs(preset) * repeat;
+}
+} // namespace BuzzerPattern
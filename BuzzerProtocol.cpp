@@ -0,0 +1,195 @@
+#include "BuzzerProtocol.h"
+
+// ------------------------------ Input ------------------------------
+bool BuzzerProtocol::feed(uint8_t c) {
+  switch (_state) {
+    case State::Idle:
+      if (c == FRAME_START) {
+        _state = State::Length;
+      } else if (c != '\n' && c != '\r' && c != ' ' && c != '\t') {
+        _op = (char)(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        _argc = 0;
+        _digit = false;
+        _bad = false;
+        _state = State::Line;
+      }
+      return false;
+
+    case State::Line:
+      if (c != '\n' && c != '\r') {
+        _lineByte(c);
+        return false;
+      }
+      _state = State::Idle;
+      {
+        const BuzzerProtocolStatus s = (_bad || (_argc != 0 && !_digit)) ? BuzzerProtocolStatus::BadArgument
+                                                                        : _apply(_op, _argc, _args);
+        _replyLine(_op, s);
+        return _complete(s);
+      }
+
+    case State::Length:
+      if (c == 0 || c > MAX_FRAME) {
+        _state = State::Idle;
+        _replyFrame(0, BuzzerProtocolStatus::BadLength);
+        return _complete(BuzzerProtocolStatus::BadLength);
+      }
+      _len = c;
+      _got = 0;
+      _sum = c;
+      _state = State::Body;
+      return false;
+
+    case State::Body:
+      _frame[_got++] = c;
+      _sum ^= c;
+      if (_got == _len) _state = State::Check;
+      return false;
+
+    case State::Check:
+    default:
+      _state = State::Idle;
+      {
+        const BuzzerProtocolStatus s = c != _sum ? BuzzerProtocolStatus::BadChecksum : _frameCommand();
+        _replyFrame(_frame[0], s);
+        return _complete(s);
+      }
+  }
+}
+
+uint8_t BuzzerProtocol::poll(Stream& in, uint8_t maxBytes) {
+  uint8_t done = 0;
+  for (int avail = in.available(); avail > 0 && maxBytes > 0; --avail, --maxBytes) {
+    const int c = in.read();
+    if (c < 0) break;
+    if (feed((uint8_t)c)) ++done;
+  }
+  return done;
+}
+
+// One byte of an ASCII line after its letter: digits, commas between arguments, spaces.
+void BuzzerProtocol::_lineByte(uint8_t c) {
+  if (_bad || c == ' ' || c == '\t') return;
+  if (c >= '0' && c <= '9') {
+    if (_argc == 0) { _args[0] = 0; _argc = 1; }
+    uint32_t& a = _args[_argc - 1];
+    const uint8_t d = (uint8_t)(c - '0');
+    if (a > (0xFFFFFFFFUL - d) / 10) { _bad = true; return; }
+    a = a * 10 + d;
+    _digit = true;
+    return;
+  }
+  if (c == ',' && _digit && _argc < MAX_ARGS) {
+    _args[_argc++] = 0;
+    _digit = false;
+    return;
+  }
+  _bad = true;
+}
+
+bool BuzzerProtocol::_complete(BuzzerProtocolStatus status) {
+  _status = status;
+  _commands++;
+  if (status != BuzzerProtocolStatus::Ok) _errors++;
+  return true;
+}
+
+// ------------------------------ Commands ------------------------------
+BuzzerProtocolStatus BuzzerProtocol::_frameCommand() {
+  const uint8_t* f = _frame;
+  uint32_t args[MAX_ARGS] = {0, 0, 0};
+  switch (f[0]) {
+    case 0x01:
+      if (_len != 4) return BuzzerProtocolStatus::BadLength;
+      args[0] = f[1];
+      args[1] = (uint32_t)f[2] | ((uint32_t)f[3] << 8);
+      return _apply('P', 2, args);
+    case 0x02:
+      if (_len != 7) return BuzzerProtocolStatus::BadLength;
+      args[0] = (uint32_t)f[1] | ((uint32_t)f[2] << 8);
+      args[1] = (uint32_t)f[3] | ((uint32_t)f[4] << 8);
+      args[2] = (uint32_t)f[5] | ((uint32_t)f[6] << 8);
+      return _apply('B', 3, args);
+    case 0x03:
+      return _len != 1 ? BuzzerProtocolStatus::BadLength : _apply('S', 0, args);
+    case 0x04:
+      return _len != 1 ? BuzzerProtocolStatus::BadLength : _apply('Q', 0, args);
+    default:
+      return BuzzerProtocolStatus::UnknownCommand;
+  }
+}
+
+BuzzerProtocolStatus BuzzerProtocol::_apply(char op, uint8_t argc, const uint32_t* args) {
+  if (op != 'P' && op != 'B' && op != 'S' && op != 'Q') return BuzzerProtocolStatus::UnknownCommand;
+  if (!_bz.getInitFlag()) return BuzzerProtocolStatus::NotInitialized;
+
+  switch (op) {
+    case 'P':
+      if (argc < 1 || argc > 2 || args[0] > (uint32_t)BuzzerPreset::MorseSOS) return BuzzerProtocolStatus::BadArgument;
+      _bz.playPreset((BuzzerPreset)args[0], true, argc > 1 ? args[1] : 1);
+      return BuzzerProtocolStatus::Ok;
+    case 'B':
+      if (argc < 2 || args[0] == 0 || args[0] > 0xFFFF || args[1] > 0xFFFF) return BuzzerProtocolStatus::BadArgument;
+      _bz.startBlink((uint16_t)args[0], (uint16_t)args[1], argc > 2 ? args[2] : 0);
+      return BuzzerProtocolStatus::Ok;
+    case 'S':
+      if (argc != 0) return BuzzerProtocolStatus::BadArgument;
+      _bz.stopAll();
+      return BuzzerProtocolStatus::Ok;
+    default:   // 'Q': the reply carries the answer
+      return argc != 0 ? BuzzerProtocolStatus::BadArgument : BuzzerProtocolStatus::Ok;
+  }
+}
+
+// ------------------------------ Replies ------------------------------
+void BuzzerProtocol::_replyLine(char op, BuzzerProtocolStatus status) {
+  if (_reply == nullptr) return;
+  if (status != BuzzerProtocolStatus::Ok) {
+    _reply->print(F("ERR "));
+    _reply->println((unsigned)status);
+    return;
+  }
+  if (op != 'Q') {
+    _reply->println(F("OK"));
+    return;
+  }
+  _reply->print(F("Q "));
+  _reply->print(_bz.isBusy() ? 1U : 0U);
+#if BUZZER_ENABLE_STATS
+  const BuzzerStats s = _bz.stats();
+  _reply->print(' '); _reply->print((unsigned long)s.edges);
+  _reply->print(' '); _reply->print((unsigned long)s.misses);
+  _reply->print(' '); _reply->print((unsigned long)s.maxLateness);
+  _reply->print(' '); _reply->print((unsigned)s.dutyPermille());
+#endif
+  _reply->println();
+}
+
+void BuzzerProtocol::_replyFrame(uint8_t op, BuzzerProtocolStatus status) {
+  if (_reply == nullptr) return;
+  uint8_t body[20];
+  uint8_t n = 0;
+  body[n++] = (uint8_t)(op | 0x80);
+  body[n++] = (uint8_t)status;
+  if (op == 0x04 && status == BuzzerProtocolStatus::Ok) {
+    body[n++] = _bz.isBusy() ? 1 : 0;
+#if BUZZER_ENABLE_STATS
+    const BuzzerStats s = _bz.stats();
+    const uint32_t fields[3] = {s.edges, s.misses, s.maxLateness};
+    for (uint8_t i = 0; i < 3; ++i) {
+      for (uint8_t b = 0; b < 4; ++b) body[n++] = (uint8_t)(fields[i] >> (8 * b));
+    }
+    const uint16_t duty = s.dutyPermille();
+    body[n++] = (uint8_t)duty;
+    body[n++] = (uint8_t)(duty >> 8);
+#endif
+  }
+  uint8_t sum = n;
+  _reply->write(FRAME_START);
+  _reply->write(n);
+  for (uint8_t i = 0; i < n; ++i) {
+    _reply->write(body[i]);
+    sum ^= body[i];
+  }
+  _reply->write(sum);
+}
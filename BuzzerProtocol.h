@@ -0,0 +1,128 @@
+#pragma once
+#include <Arduino.h>
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerProtocol.h
+ * @brief Incremental, allocation-free command parser for remote control over a serial link.
+ *
+ * Bytes are fed one at a time (feed()) or a bounded number per call from a Stream (poll()).
+ * Each byte costs a few comparisons; arguments are accumulated as they arrive, without a line
+ * buffer, and a completed command is applied to the Buzzer at once (non-blocking calls only).
+ * poll() reads at most its budget and never waits for data, so it can sit next to update()
+ * in loop() without delaying edges.
+ *
+ * ASCII (terse, one command per line, `\n` or `\r` ends it, case and spaces ignored):
+ * - `P<n>[,<repeat>]`             playPreset(n, non-blocking, repeat = 1)
+ * - `B<on>,<off>[,<repeat>]`      startBlink(on, off, repeat = 0)
+ * - `S`                           stopAll()
+ * - `Q`                           query: `Q <busy>` plus, with BUZZER_ENABLE_STATS,
+ *                                 ` <edges> <misses> <maxLateness> <dutyPermille>`
+ * Replies: `OK`, `ERR <status>` or the query line, each ending in CR LF.
+ *
+ * Binary frames (start at a line boundary with 0xA5; little-endian fields):
+ * - `A5 LEN OP ARGS.. CHK`, LEN = bytes of OP and ARGS (1..8), CHK = XOR of LEN, OP and ARGS
+ * - OP 0x01 preset  : n (u8), repeat (u16)
+ * - OP 0x02 blink   : on (u16), off (u16), repeat (u16)
+ * - OP 0x03 stop
+ * - OP 0x04 query
+ * Replies are frames with OP | 0x80 (0x80 if LEN was invalid) and ARGS = status (u8); a query
+ * adds busy (u8) and, with BUZZER_ENABLE_STATS, edges, misses, maxLateness (u32 each) and
+ * dutyPermille (u16), for a LEN of up to 17.
+ *
+ * Replies go to the Print given to the constructor (none if nullptr). The longest is 43 bytes
+ * (ASCII query with stats), within the 64-byte transmit buffer of HardwareSerial: replies do not
+ * block as long as the link drains them faster than the controller asks.
+ *
+ * @code
+ * Buzzer bz;
+ * BuzzerProtocol remote(bz, &Serial);
+ *
+ * void setup() { Serial.begin(115200); bz.init(); }
+ * void loop() {
+ *   remote.poll(Serial);
+ *   bz.update();
+ * }
+ * @endcode
+ */
+
+/** @enum BuzzerProtocolStatus
+ *  @brief Outcome of one parsed command.
+ */
+enum class BuzzerProtocolStatus : uint8_t {
+  Ok = 0,          ///< Applied
+  UnknownCommand,  ///< Letter or OP not in the protocol
+  BadArgument,     ///< Missing, extra, malformed or out-of-range argument
+  BadChecksum,     ///< Binary frame CHK mismatch
+  BadLength,       ///< Binary frame LEN outside 1..8 or not matching OP
+  NotInitialized   ///< The Buzzer has not been initialized
+};
+
+/**
+ * @class BuzzerProtocol
+ * @brief Byte-at-a-time parser of ASCII lines and binary frames driving one Buzzer.
+ */
+class BuzzerProtocol {
+public:
+  static constexpr uint8_t FRAME_START = 0xA5;
+
+  /** @brief Control @p bz (referenced); replies go to @p reply if not nullptr. */
+  explicit BuzzerProtocol(Buzzer& bz, Print* reply = nullptr) : _bz(bz), _reply(reply) {}
+
+  /**
+   * @brief Parse one byte.
+   * @return true if it completed a command (applied or rejected, see lastStatus()).
+   */
+  bool feed(uint8_t c);
+
+  /**
+   * @brief Feed up to @p maxBytes bytes that @p in has already received.
+   * @return Commands completed.
+   */
+  uint8_t poll(Stream& in, uint8_t maxBytes = 32);
+
+  /** @brief Drop a partly received command. */
+  void reset() { _state = State::Idle; }
+
+  /** @brief Status of the last completed command. */
+  BuzzerProtocolStatus lastStatus() const { return _status; }
+
+  /** @brief Commands completed (applied or rejected) since construction. */
+  uint32_t commands() const { return _commands; }
+
+  /** @brief Rejected commands since construction. */
+  uint32_t errors() const { return _errors; }
+
+private:
+  enum class State : uint8_t { Idle = 0, Line, Length, Body, Check };
+  static constexpr uint8_t MAX_ARGS = 3;
+  static constexpr uint8_t MAX_FRAME = 8;
+
+  void _lineByte(uint8_t c);
+  bool _complete(BuzzerProtocolStatus status);
+  BuzzerProtocolStatus _frameCommand();
+  BuzzerProtocolStatus _apply(char op, uint8_t argc, const uint32_t* args);
+  void _replyLine(char op, BuzzerProtocolStatus status);
+  void _replyFrame(uint8_t op, BuzzerProtocolStatus status);
+
+  Buzzer& _bz;
+  Print*  _reply;
+
+  // ASCII line: letter, then arguments accumulated digit by digit.
+  uint32_t _args[MAX_ARGS];
+  char     _op = 0;
+  uint8_t  _argc = 0;
+  bool     _digit = false;          ///< current argument has a digit
+  bool     _bad = false;            ///< line already malformed, wait for its end
+
+  // Binary frame.
+  uint8_t  _frame[MAX_FRAME];
+  uint8_t  _len = 0;
+  uint8_t  _got = 0;
+  uint8_t  _sum = 0;
+
+  State    _state = State::Idle;
+  BuzzerProtocolStatus _status = BuzzerProtocolStatus::Ok;
+  uint32_t _commands = 0;
+  uint32_t _errors = 0;
+};
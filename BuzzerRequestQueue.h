@@ -0,0 +1,248 @@
+#pragma once
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerRequestQueue.h
+ * @brief Priority arbitration for one Buzzer: higher-priority sounds preempt, lower ones resume.
+ *
+ * Each priority level (0..255, higher wins) holds at most one sound:
+ * - A request above the playing level preempts it. The preempted sound is saved (engine state
+ *   and the time left in its current step) and resumes exactly where it stopped once every
+ *   higher level has finished or been cancelled.
+ * - A request below the playing level waits for its turn.
+ * - A request at an occupied level replaces that level's sound, unless it is the same command:
+ *   re-requesting a running or suspended sound is a no-op, so loop() may re-post status sounds
+ *   every pass without restarting them.
+ *
+ * Storage is fixed: CAPACITY suspended or waiting sounds besides the playing one. When full,
+ * a new level evicts the lowest waiting level if that one ranks below it; otherwise the request
+ * is rejected.
+ *
+ * While the queue owns a buzzer, command it only through the queue (or call cancel()/stopAll()),
+ * and call the queue's update() instead of the buzzer's.
+ *
+ * @code
+ * Buzzer bz;
+ * BuzzerRequestQueue<3> sounds(bz);
+ *
+ * void setup() { bz.init(); sounds.playPreset(0, BuzzerPreset::Heartbeat, 0); }
+ *
+ * void loop() {
+ *   if (overTemp) sounds.playPreset(2, BuzzerPreset::Alarm, 2); // heartbeat pauses, then resumes
+ *   sounds.update();
+ * }
+ * @endcode
+ */
+template <uint8_t CAPACITY>
+class BuzzerRequestQueue {
+  static_assert(CAPACITY > 0 && CAPACITY < 255, "BuzzerRequestQueue: CAPACITY must be 1..254");
+
+public:
+  /** @brief Arbitrate sounds of @p bz (referenced, must outlive the queue). */
+  explicit BuzzerRequestQueue(Buzzer& bz) : _bz(bz) {}
+
+  // -------------------- Requests --------------------
+  /**
+   * @brief Request a StartBlink, PlayPreset or PlayPattern command at @p priority.
+   * @return false if @p bz is not initialized, the command is invalid or no slot is left.
+   *         A Stop command cancels @p priority.
+   */
+  bool request(uint8_t priority, const BuzzerCommand& cmd) {
+    if (!_bz.getInitFlag()) return false;
+    if (cmd.type == BuzzerCommand::Type::Stop) { cancel(priority); return true; }
+
+    BuzzerEngine& eng = _bz._engine;
+    const unsigned long now = eng.now();
+
+    if (_active && priority == _priority) {
+      if (_same(cmd, _cmd)) return true;
+      return _start(priority, cmd, now);                    // replace the playing sound
+    }
+
+    const int w = _find(priority);
+    if (w >= 0) {
+      if (_same(cmd, _waiting[w].cmd)) return true;
+      return _prepare(_waiting[w], priority, cmd);           // replace in place, keep its rank
+    }
+
+    if (!_active) return _start(priority, cmd, now);
+
+    if (priority < _priority) {
+      Entry e;
+      return _prepare(e, priority, cmd) && _insert(e);
+    }
+
+    // Preempt: save the playing sound with the time left in its current step.
+    Entry next;
+    if (!_prepare(next, priority, cmd)) return false;
+    Entry saved;
+    saved.cmd      = _cmd;
+    saved.priority = _priority;
+    saved.engine   = eng;
+    saved.remain   = eng.timeUntilNext(now);
+    if (!_insert(saved)) return false;
+    return _resume(next, now);
+  }
+
+  /** @brief Request Buzzer::startBlink() at @p priority. */
+  bool startBlink(uint8_t priority, uint16_t on_ms, uint16_t off_ms, uint32_t repeat = 0) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::StartBlink;
+    c.onMs = on_ms; c.offMs = off_ms; c.repeat = repeat;
+    return request(priority, c);
+  }
+
+  /** @brief Request a non-blocking Buzzer::playPreset() at @p priority. */
+  bool playPreset(uint8_t priority, BuzzerPreset preset, uint32_t repeat = 1) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::PlayPreset;
+    c.preset = preset; c.repeat = repeat;
+    return request(priority, c);
+  }
+
+  /** @brief Request Buzzer::playPattern() at @p priority. */
+  bool playPattern(uint8_t priority, const uint16_t* steps, uint32_t repeat = 1) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::PlayPattern;
+    c.pattern = steps; c.repeat = repeat;
+    return request(priority, c);
+  }
+
+  /** @brief Drop the sound at @p priority; if it was playing, the next level resumes now. */
+  void cancel(uint8_t priority) {
+    if (_active && priority == _priority) {
+      const bool was = _bz._engine.isOn();
+      _bz._engine.stop();
+      _bz._sync(was);
+      _active = false;
+      _resumeNext(_bz._engine.now());
+      return;
+    }
+    const int w = _find(priority);
+    if (w >= 0) _erase((uint8_t)w);
+  }
+
+  /** @brief Drop every sound and turn the buzzer OFF. */
+  void stopAll() {
+    _count = 0;
+    _active = false;
+    _bz.stopAll();
+  }
+
+  // -------------------- Scheduler --------------------
+  /** @brief Advance the buzzer and resume the next level when the playing sound ends. */
+  void update() {
+    if (!_active && _count == 0) return;
+    update(_bz._engine.now());
+  }
+
+  /** @brief update() with a caller-supplied clock value of the buzzer's timebase. */
+  void update(unsigned long now) {
+    _bz.update(now);
+    if (!_active || _bz.isBusy()) return;
+    // The sound ended at its last deadline: resume from there so lateness does not accumulate.
+    _active = false;
+    _resumeNext(_bz._engine.deadline());
+    _bz.update(now);
+  }
+
+  // -------------------- State --------------------
+  /** @brief Whether a sound is playing or waiting. */
+  bool isBusy() const { return _active || _count > 0; }
+
+  /** @brief Priority of the playing sound (meaningful while isBusy()). */
+  uint8_t activePriority() const { return _priority; }
+
+  /** @brief Number of suspended or waiting sounds. */
+  uint8_t pendingCount() const { return _count; }
+
+private:
+  struct Entry {
+    BuzzerCommand cmd;
+    BuzzerEngine  engine;     ///< saved or prepared engine state
+    unsigned long remain = 0; ///< ticks left in the saved step
+    uint8_t       priority = 0;
+  };
+
+  Buzzer&       _bz;
+  Entry         _waiting[CAPACITY];  ///< sorted by priority, highest first
+  uint8_t       _count = 0;
+  BuzzerCommand _cmd;                ///< playing command
+  uint8_t       _priority = 0;       ///< playing level
+  bool          _active = false;
+
+  static bool _same(const BuzzerCommand& a, const BuzzerCommand& b) {
+    if (a.type != b.type || a.repeat != b.repeat) return false;
+    switch (a.type) {
+      case BuzzerCommand::Type::StartBlink:  return a.onMs == b.onMs && a.offMs == b.offMs;
+      case BuzzerCommand::Type::PlayPreset:  return a.preset == b.preset;
+      case BuzzerCommand::Type::PlayPattern: return a.pattern == b.pattern;
+      default:                               return true;
+    }
+  }
+
+  // Start @p cmd on a blank engine with the buzzer's configuration; false if it plays nothing.
+  bool _prepare(Entry& e, uint8_t priority, const BuzzerCommand& cmd) const {
+    BuzzerEngine eng;
+    eng.setCatchUp(_bz._engine.catchUp());
+    eng.setTimebase(_bz._engine.timebase());
+    eng.apply(cmd, 0);
+    if (!eng.isBusy()) return false;
+    e.cmd      = cmd;
+    e.priority = priority;
+    e.engine   = eng;
+    e.remain   = eng.timeUntilNext(0);
+    return true;
+  }
+
+  bool _start(uint8_t priority, const BuzzerCommand& cmd, unsigned long now) {
+    Entry e;
+    if (!_prepare(e, priority, cmd)) return false;
+    return _resume(e, now);
+  }
+
+  // Hand a saved or prepared sound to the buzzer, its current step ending e.remain after @p now.
+  bool _resume(const Entry& e, unsigned long now) {
+    BuzzerEngine& eng = _bz._engine;
+    if (e.engine.timebase() != eng.timebase()) return false; // saved under another clock
+    const bool was = eng.isOn();
+    const BuzzerCatchUp policy = eng.catchUp();
+    eng = e.engine;
+    eng.setCatchUp(policy);
+    eng.rebase(e.remain, now);
+    _bz._sync(was);
+    _cmd = e.cmd;
+    _priority = e.priority;
+    _active = true;
+    return true;
+  }
+
+  void _resumeNext(unsigned long now) {
+    while (_count > 0 && !_active) {
+      const Entry e = _waiting[0];
+      _erase(0);
+      _resume(e, now);
+    }
+  }
+
+  int _find(uint8_t priority) const {
+    for (uint8_t i = 0; i < _count; ++i) if (_waiting[i].priority == priority) return i;
+    return -1;
+  }
+
+  bool _insert(const Entry& e) {
+    if (_count == CAPACITY) {
+      if (_waiting[_count - 1].priority >= e.priority) return false;
+      _count--;                                              // evict the lowest level
+    }
+    uint8_t i = _count++;
+    for (; i > 0 && _waiting[i - 1].priority < e.priority; --i) _waiting[i] = _waiting[i - 1];
+    _waiting[i] = e;
+    return true;
+  }
+
+  void _erase(uint8_t i) {
+    for (; i + 1 < _count; ++i) _waiting[i] = _waiting[i + 1];
+    _count--;
+  }
+};
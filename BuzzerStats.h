@@ -0,0 +1,86 @@
+#pragma once
+#include <Arduino.h>
+#include "BuzzerConfig.h"
+
+/**
+ * @file BuzzerStats.h
+ * @brief Optional scheduler counters for Buzzer (update() calls, edges, lateness, ON time).
+ *
+ * Compiled in only with BUZZER_ENABLE_STATS=1, set in BuzzerConfig.h or as a compiler flag for the
+ * whole build (not in the sketch: the stats member changes the layout of Buzzer, and a mismatch
+ * with Buzzer.cpp fails to link). When disabled, Buzzer has no stats member and its hot path is
+ * unchanged.
+ *
+ * Times are ticks of the buzzer's ::BuzzerTimebase (ms by default). The miss threshold,
+ * BUZZER_STATS_MISS_US, is in µs and converted to the timebase (rounded down to whole ms in
+ * Millis mode), so misses mean the same in both.
+ */
+
+/** @struct BuzzerStats
+ *  @brief Snapshot of the counters (see Buzzer::stats()).
+ */
+struct BuzzerStats {
+  uint32_t updateCalls  = 0; ///< update() / update(now) calls
+  uint32_t serviced     = 0; ///< calls that found a transition due
+  uint32_t edges        = 0; ///< pin level changes
+  uint32_t misses       = 0; ///< transitions serviced more than BUZZER_STATS_MISS_US late
+  uint32_t maxLateness  = 0; ///< worst lateness of a serviced transition
+  uint32_t sumLateness  = 0; ///< total lateness of serviced transitions
+  uint32_t onTicks      = 0; ///< time the output was ON
+  uint32_t elapsedTicks = 0; ///< time since the last reset
+
+  /** @brief Mean lateness per serviced transition. */
+  uint32_t meanLateness() const { return serviced ? sumLateness / serviced : 0; }
+
+  /** @brief ON time per mille of the elapsed time. */
+  uint16_t dutyPermille() const {
+    return elapsedTicks ? (uint16_t)((uint64_t)onTicks * 1000U / elapsedTicks) : 0;
+  }
+};
+
+/**
+ * @class BuzzerStatsRecorder
+ * @brief Accumulates ::BuzzerStats from the Buzzer hot path (used by Buzzer only).
+ */
+class BuzzerStatsRecorder {
+public:
+  inline void call() { _s.updateCalls++; }
+
+  /** @brief A transition scheduled for @p deadline was serviced at @p now (µs ticks if @p micros). */
+  inline void service(unsigned long now, unsigned long deadline, bool micros) {
+    const uint32_t late = (uint32_t)(now - deadline);
+    _s.serviced++;
+    _s.sumLateness += late;
+    if (late > _s.maxLateness) _s.maxLateness = late;
+    if (late > (micros ? (uint32_t)BUZZER_STATS_MISS_US : (uint32_t)BUZZER_STATS_MISS_US / 1000U)) _s.misses++;
+  }
+
+  /** @brief The output was driven to @p on at @p now. */
+  inline void level(bool on, unsigned long now) {
+    if (on == _on) return;
+    _s.edges++;
+    if (_on) _s.onTicks += (uint32_t)(now - _onSince);
+    else     _onSince = now;
+    _on = on;
+  }
+
+  /** @brief Counters with the open ON interval and the elapsed time closed at @p now. */
+  BuzzerStats snapshot(unsigned long now) const {
+    BuzzerStats s = _s;
+    if (_on) s.onTicks += (uint32_t)(now - _onSince);
+    s.elapsedTicks = (uint32_t)(now - _since);
+    return s;
+  }
+
+  /** @brief Zero the counters; the current level stays and its ON time restarts at @p now. */
+  void reset(unsigned long now) {
+    _s = BuzzerStats();
+    _since = _onSince = now;
+  }
+
+private:
+  BuzzerStats   _s;
+  bool          _on = false;
+  unsigned long _onSince = 0;
+  unsigned long _since = 0;
+};
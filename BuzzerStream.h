@@ -0,0 +1,258 @@
+#pragma once
+#include <Arduino.h>
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerStream.h
+ * @brief Sequences of any length streamed from a Stream (Serial, SD file, flash blob) onto a Buzzer.
+ *
+ * Format (BZS1), a run-length byte stream:
+ * - `'B' 'Z' 'S' '1'` : magic
+ * - one varint per step: `(ms << 1) | level`, 7 bits per byte, low group first, bit 7 set on all
+ *   but the last byte (1 byte up to 63 ms, 2 bytes up to 8191 ms, at most 5 bytes)
+ * - `0x00` : end (OFF for 0 ms)
+ *
+ * extras/host/pattern_compile turns a text description (`+120 -80 ( +40 -40 ) x3 ...`) into it,
+ * as a file or a PROGMEM array for ::BuzzerBlobStream.
+ *
+ * ::BuzzerStreamPlayer holds a double buffer of 2 x BUFFER bytes and the next step, decoded ahead.
+ * At an edge it switches to that step, then, before returning, refills whichever half has been
+ * consumed from the Stream (only what available() reports, never blocking) and decodes the
+ * following step. Reads therefore happen between edges, and RAM use is fixed whatever the length.
+ *
+ * If a step is still missing at its edge (e.g. a slow Serial link), the output goes OFF, the
+ * underrun is counted and playback resumes as soon as the step arrives. A source that ends
+ * without the end byte leaves the player waiting; stop() it.
+ *
+ * While the player owns a buzzer, call the player's update() instead of the buzzer's.
+ *
+ * @code
+ * Buzzer bz;
+ * BuzzerStreamPlayer<> player(bz);
+ * File jingle;
+ *
+ * void setup() {
+ *   bz.init();
+ *   SD.begin(4);
+ *   jingle = SD.open("JINGLE.BZS");
+ *   player.play(jingle);
+ * }
+ * void loop() { player.update(); }
+ * @endcode
+ */
+
+/**
+ * @class BuzzerBlobStream
+ * @brief Read-only Stream over a byte array, in flash (PROGMEM) or RAM.
+ */
+class BuzzerBlobStream : public Stream {
+public:
+  BuzzerBlobStream(const uint8_t* data, size_t size, bool inFlash = true)
+    : _data(data), _size(size), _inFlash(inFlash) {}
+
+  /** @brief Start over from the first byte. */
+  void rewind() { _pos = 0; }
+
+  int available() override {
+    const size_t left = _size - _pos;
+    return left > 0x7FFF ? 0x7FFF : (int)left;
+  }
+  int peek() override { return _pos < _size ? _at(_pos) : -1; }
+  int read() override { return _pos < _size ? _at(_pos++) : -1; }
+  size_t write(uint8_t) override { return 0; }
+
+private:
+  uint8_t _at(size_t i) const { return _inFlash ? pgm_read_byte(_data + i) : _data[i]; }
+
+  const uint8_t* _data;
+  size_t _size;
+  size_t _pos = 0;
+  bool   _inFlash;
+};
+
+/**
+ * @class BuzzerStreamPlayer
+ * @brief Plays a BZS1 stream on a Buzzer with a fixed double buffer of 2 x BUFFER bytes.
+ * @tparam BUFFER Bytes per half (power of two, 8..64); a refill runs once a half is consumed.
+ */
+template <uint8_t BUFFER = 16>
+class BuzzerStreamPlayer {
+  static_assert(BUFFER >= 8 && BUFFER <= 64 && (BUFFER & (BUFFER - 1)) == 0,
+                "BuzzerStreamPlayer: BUFFER must be a power of two in 8..64");
+
+public:
+  /** @brief Play onto @p bz (referenced, must outlive the player). */
+  explicit BuzzerStreamPlayer(Buzzer& bz) : _bz(bz) {}
+
+  /**
+   * @brief Start streaming @p src (referenced until the sequence ends or stop()).
+   *
+   * Replaces the buzzer's own sound. Playback starts at once if the magic and the first step
+   * are available, else at the first update() that finds them.
+   * @return false if the buzzer is not initialized or the data is not BZS1 (see lastError()).
+   */
+  bool play(Stream& src) {
+    stop();
+    _error = BuzzerError::None;
+    _underruns = 0;
+    if (!_bz.getInitFlag()) {
+      _error = BuzzerError::NotInitialized;
+      return false;
+    }
+    BuzzerEngine& own = _bz._engine;
+    if (own.isBusy()) {
+      const bool was = own.isOn();
+      own.stop();
+      own.setOn(was);
+    }
+    _src = &src;
+    _unit = own.timebase() == BuzzerTimebase::Micros ? 1000UL : 1UL;
+    _head = _count = _magic = 0;
+    _haveNext = false;
+    _state = State::Waiting;
+    update(own.now());
+    return _error == BuzzerError::None;
+  }
+
+  /** @brief Stop, release the Stream and turn the buzzer OFF. */
+  void stop() {
+    if (_state == State::Idle) return;
+    _state = State::Idle;
+    _src = nullptr;
+    _output(false);
+  }
+
+  // -------------------- Scheduler --------------------
+  /** @brief Switch to the due step, then refill the buffer and decode the next one. Call from loop(). */
+  void update() {
+    if (_state == State::Idle) return;
+    update(_bz._engine.now());
+  }
+
+  /** @brief update() with a caller-supplied clock value of the buzzer's timebase. */
+  void update(unsigned long now) {
+    if (_state == State::Idle) return;
+    if (_state == State::Playing && (long)(now - _deadline) < 0) return;
+    if (_state == State::Waiting) {
+      if (!_fetch()) return;
+      _deadline = now;
+      _state = State::Playing;
+    }
+
+    bool on = _bz._engine.isOn();
+    while ((long)(now - _deadline) >= 0) {
+      if (!_fetch()) {
+        if (_state == State::Idle) return;       // corrupt data, stopped by _fetch()
+        if (_underruns != 0xFFFF) ++_underruns;
+        _state = State::Waiting;
+        _output(false);
+        return;
+      }
+      _haveNext = false;
+      if (_next == 0) {                          // end byte
+        _state = State::Idle;
+        _src = nullptr;
+        _output(false);
+        return;
+      }
+      on = (_next & 1u) != 0;
+      _deadline += (unsigned long)(_next >> 1) * _unit;
+    }
+    _output(on);
+    _fetch();                                    // between edges: refill and decode ahead
+  }
+
+  /** @brief Milliseconds until the next edge (0 while waiting for data, Buzzer::IDLE_FOREVER if idle). */
+  unsigned long msUntilNextEvent() const {
+    if (_state == State::Idle) return Buzzer::IDLE_FOREVER;
+    if (_state == State::Waiting) return 0;
+    const long d = (long)(_deadline - _bz._engine.now());
+    return d > 0 ? (unsigned long)d / _unit : 0;
+  }
+
+  // -------------------- State --------------------
+  /** @brief Whether a sequence is playing or waiting for data. */
+  bool isBusy() const { return _state != State::Idle; }
+
+  /** @brief Edges that found their step not yet received, since play() (saturates at 65535). */
+  uint16_t underruns() const { return _underruns; }
+
+  /** @brief Get last error (NotInitialized, InvalidStream). */
+  BuzzerError lastError() const { return _error; }
+
+private:
+  enum class State : uint8_t { Idle = 0, Waiting, Playing };
+  static constexpr uint8_t SIZE = 2 * BUFFER;
+
+  // Decoded next step ready, reading and checking the magic first. Refills a consumed half.
+  bool _fetch() {
+    if (_haveNext) return true;
+    if (_count <= BUFFER) _refill();
+    static const char kMagic[4] = {'B', 'Z', 'S', '1'};
+    while (_magic < 4 && _count > 0) {
+      if (_pop() != (uint8_t)kMagic[_magic++]) return _fail();
+    }
+    if (_magic < 4) return false;
+
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < _count; ++i) {
+      const uint8_t b = _buf[(uint8_t)(_head + i) % SIZE];
+      v |= (uint32_t)(b & 0x7F) << (7 * i);
+      if ((b & 0x80) == 0) {
+        _head = (uint8_t)((_head + i + 1) % SIZE);
+        _count = (uint8_t)(_count - i - 1);
+        _next = v;
+        _haveNext = true;
+        if (_count <= BUFFER) _refill();
+        return true;
+      }
+      if (i == 4) return _fail();                // longer than 5 bytes: not BZS1
+    }
+    return false;
+  }
+
+  // Top up the free half from what the Stream has right now.
+  void _refill() {
+    int n = _src->available();
+    if (n > SIZE - _count) n = SIZE - _count;
+    for (; n > 0; --n) {
+      const int c = _src->read();
+      if (c < 0) break;
+      _buf[(uint8_t)(_head + _count) % SIZE] = (uint8_t)c;
+      ++_count;
+    }
+  }
+
+  uint8_t _pop() {
+    const uint8_t b = _buf[_head];
+    _head = (uint8_t)((_head + 1) % SIZE);
+    --_count;
+    return b;
+  }
+
+  bool _fail() {
+    _error = BuzzerError::InvalidStream;
+    stop();
+    return false;
+  }
+
+  void _output(bool on) {
+    if (!_bz.getInitFlag() || on == _bz._engine.isOn()) return;
+    _bz._engine.setOn(on);
+    _bz._write(on);
+  }
+
+  Buzzer&       _bz;
+  Stream*       _src = nullptr;
+  unsigned long _deadline = 0;      ///< end of the current step
+  unsigned long _unit = 1;          ///< clock ticks per ms
+  uint32_t      _next = 0;          ///< decoded step value, valid if _haveNext
+  uint16_t      _underruns = 0;
+  uint8_t       _buf[SIZE];
+  uint8_t       _head = 0;          ///< oldest unread byte
+  uint8_t       _count = 0;         ///< unread bytes
+  uint8_t       _magic = 0;         ///< magic bytes checked so far
+  bool          _haveNext = false;
+  State         _state = State::Idle;
+  BuzzerError   _error = BuzzerError::None;
+};
@@ -0,0 +1,210 @@
+#include "BuzzerTone.h"
+
+// ------------------------------ Tables ------------------------------
+namespace {
+using namespace BuzzerTone;
+
+// 2^(i/16) in Q16, i = 0..16: one octave of the pitch → increment conversion (linear in between).
+const uint32_t kExp2[17] PROGMEM = {
+  65536, 68438, 71468, 74632, 77936, 81386, 84990, 88752, 92682,
+  96785, 101070, 105545, 110218, 115098, 120194, 125515, 131072
+};
+
+inline uint32_t exp2At(uint8_t i) { return pgm_read_dword(&kExp2[i]); }
+
+// Same envelope as the step tables (2000 ms ON, 200 ms OFF), but gliding up and down an octave+.
+const BuzzerToneStep kToneAlarm[] PROGMEM   = {
+  sweepExp(700, 1800, 1000), sweepExp(1800, 700, 1000), rest(200), end()
+};
+// C6 then G6, with the Success timing (100 ms, 50 ms gap, 400 ms, 200 ms gap).
+const BuzzerToneStep kToneSuccess[] PROGMEM = { note(1047, 100), rest(50), note(1568, 400), rest(200), end() };
+} // namespace
+
+const BuzzerToneStep* BuzzerToneEngine::presetTones(BuzzerPreset preset) {
+  switch (preset) {
+    case BuzzerPreset::Alarm:   return kToneAlarm;
+    case BuzzerPreset::Success: return kToneSuccess;
+    default:                    return nullptr;
+  }
+}
+
+// ------------------------------ Pitch (log2 of the increment, Q16) ------------------------------
+int32_t BuzzerToneEngine::_incToPitch(uint32_t inc) {
+  uint8_t e = 31;
+  while (e > 0 && !(inc & (1UL << e))) e--;
+  const uint32_t m = e >= 16 ? inc >> (e - 16) : inc << (16 - e);   // [1, 2) in Q16
+  uint8_t i = 0;
+  while (i < 15 && exp2At(i + 1) <= m) i++;
+  const uint32_t a = exp2At(i), b = exp2At(i + 1);
+  return ((int32_t)e << 16) | ((int32_t)i << 12) | (int32_t)(((m - a) << 12) / (b - a));
+}
+
+uint32_t BuzzerToneEngine::_pitchToInc(int32_t pitch) {
+  const uint8_t  e = (uint8_t)(pitch >> 16);
+  const uint8_t  i = (uint8_t)((pitch >> 12) & 0x0F);
+  const uint32_t r = (uint32_t)pitch & 0x0FFF;
+  const uint32_t a = exp2At(i), b = exp2At(i + 1);
+  const uint32_t m = a + (((b - a) * r) >> 12);
+  return e >= 16 ? m << (e - 16) : m >> (16 - e);
+}
+
+// ------------------------------ Commands ------------------------------
+void BuzzerToneEngine::begin(uint32_t sample_hz) {
+  _incPerHz   = (uint32_t)((1ULL << 40) / sample_hz);
+  _ctrlPeriod = (uint16_t)(sample_hz / 1000UL);
+  _ctrlLeft   = _ctrlPeriod;
+  _env.reset();
+  stop();
+}
+
+void BuzzerToneEngine::tone(uint16_t hz) {
+  if (hz == 0) { stop(); return; }
+  _mode = Mode::Tone;
+  _inc  = hzToInc(hz);
+}
+
+void BuzzerToneEngine::playTones(const BuzzerToneStep* steps, uint32_t repeat) {
+  if (steps == nullptr) return;
+  _mode  = Mode::Steps;
+  _steps = steps;
+  _step  = 0;
+  _repeatRemain = repeat; // 0 ⇒ infinite
+  _ctrlLeft = _ctrlPeriod;
+  if (!_nextToneStep()) stop();
+}
+
+void BuzzerToneEngine::playPattern(const uint16_t* steps, uint32_t repeat, uint16_t hz) {
+  _ms = 0;
+  _env.playPattern(steps, repeat, _ms);
+  if (!_env.isBusy()) { stop(); return; }
+  _mode = Mode::Gate;
+  _carrierInc = hzToInc(hz);
+  _ctrlLeft = _ctrlPeriod;
+  _inc = _env.isOn() ? _carrierInc : 0;
+  _phase = 0;
+}
+
+void BuzzerToneEngine::playPreset(BuzzerPreset preset, uint32_t repeat, uint16_t hz) {
+  const BuzzerToneStep* tones = presetTones(preset);
+  if (tones) playTones(tones, repeat);
+  else       playPattern(BuzzerEngine::presetTable(preset), repeat, hz);
+}
+
+// ------------------------------ Control step (every 1 ms of ticks) ------------------------------
+// Enter the next entry of the tone table. Returns false once the last pass has ended.
+bool BuzzerToneEngine::_nextToneStep() {
+  for (uint8_t guard = 0; guard < 2; ++guard) {
+    const uint16_t ms = pgm_read_word(&_steps[_step].ms);
+    if ((ms & MS_MASK) == 0) {             // end(): one pass done
+      if (_step == 0) return false;        // empty table
+      if (_repeatRemain == 1) return false;
+      if (_repeatRemain > 1)  _repeatRemain--;
+      _step = 0;
+      continue;
+    }
+
+    const uint16_t from = pgm_read_word(&_steps[_step].fromHz);
+    const uint16_t to   = pgm_read_word(&_steps[_step].toHz);
+    _step++;
+    _msLeft = ms & MS_MASK;
+
+    if (from == 0) {                       // rest: park the phase so the output stays LOW
+      _sweep = Sweep::None;
+      _inc = 0; _phase = 0;
+      return true;
+    }
+
+    const uint32_t inc0 = hzToInc(from);
+    _inc = inc0;
+    if (to == from) {
+      _sweep = Sweep::None;
+    } else if (ms & EXP_BIT) {
+      _sweep = Sweep::Exp;
+      _pitch = _incToPitch(inc0);
+      _delta = (_incToPitch(hzToInc(to)) - _pitch) / (int32_t)_msLeft;
+    } else {
+      _sweep = Sweep::Linear;
+      _delta = ((int32_t)hzToInc(to) - (int32_t)inc0) / (int32_t)_msLeft;
+    }
+    return true;
+  }
+  return false;
+}
+
+void BuzzerToneEngine::_control() {
+  _ctrlLeft = _ctrlPeriod;
+  switch (_mode) {
+    case Mode::Steps:
+      if (--_msLeft == 0) {
+        if (!_nextToneStep()) stop();
+      } else if (_sweep == Sweep::Linear) {
+        _inc += (uint32_t)_delta;
+      } else if (_sweep == Sweep::Exp) {
+        _pitch += _delta;
+        _inc = _pitchToInc(_pitch);
+      }
+      break;
+
+    case Mode::Gate:
+      ++_ms;
+      if (_env.isDue(_ms)) _env.advance(_ms);
+      if (!_env.isBusy()) { stop(); break; }
+      if (!_env.isOn())   { _inc = 0; _phase = 0; }
+      else if (_inc == 0) _inc = _carrierInc;
+      break;
+
+    case Mode::Idle: case Mode::Tone: default: break;
+  }
+}
+
+// ------------------------------ PassiveBuzzer ------------------------------
+PassiveBuzzer::~PassiveBuzzer() {
+  if (_initFlag && parameters.PIN_NUM >= 0) {
+    pinMode(parameters.PIN_NUM, INPUT);
+  }
+}
+
+bool PassiveBuzzer::init() {
+  _initFlag  = false;
+  _lastError = BuzzerError::None;
+
+  if (parameters.PIN_NUM < 0 || !_gpio.attach((uint8_t)parameters.PIN_NUM)) {
+    _lastError = BuzzerError::InvalidPin;
+    return false;
+  }
+  if (parameters.SAMPLE_HZ < 1000UL || parameters.SAMPLE_HZ > 1000000UL) {
+    _lastError = BuzzerError::InvalidSampleRate;
+    return false;
+  }
+
+  pinMode(parameters.PIN_NUM, OUTPUT);
+  digitalWrite(parameters.PIN_NUM, LOW); // also detaches a PWM timer from the pin
+  _level = false;
+  _engine.begin(parameters.SAMPLE_HZ);
+  __atomic_store_n(&_posted, (uint8_t)0, __ATOMIC_RELEASE);
+
+  _initFlag = true;
+  return true;
+}
+
+void PassiveBuzzer::_post(Cmd cmd, const void* table, uint32_t repeat, uint16_t arg) {
+  if (!_initFlag) { _lastError = BuzzerError::NotInitialized; return; }
+  // Withdraw a pending command first: tick() (which runs to completion) never sees a half-written one.
+  __atomic_store_n(&_posted, (uint8_t)0, __ATOMIC_RELEASE);
+  _cmd    = cmd;
+  _table  = table;
+  _repeat = repeat;
+  _arg    = arg;
+  __atomic_store_n(&_posted, (uint8_t)1, __ATOMIC_RELEASE);
+}
+
+void PassiveBuzzer::_apply() {
+  switch (_cmd) {
+    case Cmd::Tone:    _engine.tone(_arg); break;
+    case Cmd::Tones:   _engine.playTones(static_cast<const BuzzerToneStep*>(_table), _repeat); break;
+    case Cmd::Preset:  _engine.playPreset(static_cast<BuzzerPreset>(_arg), _repeat, parameters.CARRIER_HZ); break;
+    case Cmd::Pattern: _engine.playPattern(static_cast<const uint16_t*>(_table), _repeat, parameters.CARRIER_HZ); break;
+    case Cmd::Stop:    _engine.stop(); break;
+  }
+  __atomic_store_n(&_posted, (uint8_t)0, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <Arduino.h>
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerTone.h
+ * @brief Square-wave tones for passive piezos: phase-accumulator (DDS) carrier, sweeps, note tables.
+ *
+ * An active buzzer only needs ON/OFF; a passive piezo needs the audio square wave itself.
+ * ::BuzzerToneEngine generates it from a periodic timer tick:
+ * - each tick adds a 32-bit phase increment and outputs the phase MSB (one add, no floating point),
+ * - once per millisecond of ticks a control step advances sweeps and note tables,
+ * - linear sweeps step the increment, exponential sweeps step a log2 pitch (1/65536 octave)
+ *   converted back through a 17-entry 2^x table.
+ *
+ * ::PassiveBuzzer drives one pin with it. Call its tick() from a timer interrupt at SAMPLE_HZ;
+ * several channels can share the same interrupt.
+ *
+ * @code
+ * static const BuzzerToneStep kChime[] PROGMEM = {
+ *   BuzzerTone::note(1047, 120), BuzzerTone::rest(30),
+ *   BuzzerTone::sweepExp(1047, 2093, 250), BuzzerTone::end()
+ * };
+ *
+ * PassiveBuzzer pz;                 // parameters.PIN_NUM = 9; SAMPLE_HZ = 20000
+ * ISR(TIMER2_COMPA_vect) { pz.tick(); }
+ *
+ * pz.playTones(kChime);                          // note sequence with a sweep
+ * pz.playPreset(BuzzerPreset::Alarm, 0);         // swept siren
+ * pz.playPreset(BuzzerPreset::Heartbeat, 0);     // preset timing, gated CARRIER_HZ
+ * @endcode
+ */
+
+/** @struct BuzzerToneStep
+ *  @brief One step of a PROGMEM tone table (build with the ::BuzzerTone helpers).
+ */
+struct BuzzerToneStep {
+  uint16_t fromHz; ///< Start frequency (0 ⇒ rest)
+  uint16_t toHz;   ///< End frequency (== fromHz ⇒ steady note)
+  uint16_t ms;     ///< [14..0] duration in ms, [15] exponential sweep; 0 ⇒ end of table
+};
+
+/**
+ * @namespace BuzzerTone
+ * @brief Builders of ::BuzzerToneStep entries.
+ */
+namespace BuzzerTone {
+  static constexpr uint16_t EXP_BIT = 0x8000; ///< Sweep in pitch (constant ratio per ms)
+  static constexpr uint16_t MS_MASK = 0x7FFF; ///< Duration bits
+
+  /** @brief Steady note of @p hz for @p ms (1..32767). */
+  constexpr BuzzerToneStep note(uint16_t hz, uint16_t ms) {
+    return BuzzerToneStep{hz, hz, (uint16_t)(ms & MS_MASK)};
+  }
+  /** @brief Silence for @p ms. */
+  constexpr BuzzerToneStep rest(uint16_t ms) { return BuzzerToneStep{0, 0, (uint16_t)(ms & MS_MASK)}; }
+  /** @brief Linear sweep (constant Hz per ms) from @p from_hz to @p to_hz. */
+  constexpr BuzzerToneStep sweep(uint16_t from_hz, uint16_t to_hz, uint16_t ms) {
+    return BuzzerToneStep{from_hz, to_hz, (uint16_t)(ms & MS_MASK)};
+  }
+  /** @brief Exponential sweep (constant octaves per ms), the usual siren glide. */
+  constexpr BuzzerToneStep sweepExp(uint16_t from_hz, uint16_t to_hz, uint16_t ms) {
+    return BuzzerToneStep{from_hz, to_hz, (uint16_t)((ms & MS_MASK) | EXP_BIT)};
+  }
+  /** @brief Terminator of a tone table. */
+  constexpr BuzzerToneStep end() { return BuzzerToneStep{0, 0, 0}; }
+}
+
+/**
+ * @class BuzzerToneEngine
+ * @brief Pin-agnostic DDS square-wave generator; tick() returns the output level.
+ *
+ * Frequencies must stay below SAMPLE_HZ / 2; edges land on tick boundaries, so each half period
+ * jitters by up to one tick while the average frequency is exact to 1/2^32 of SAMPLE_HZ.
+ */
+class BuzzerToneEngine {
+public:
+  /** @brief Set the tick rate (1000..1000000 Hz, a multiple of 1000 keeps table times exact) and stop. */
+  void begin(uint32_t sample_hz);
+
+  // -------------------- Commands --------------------
+  /** @brief Continuous square wave of @p hz (0 ⇒ stop). */
+  void tone(uint16_t hz);
+
+  /** @brief Play a PROGMEM ::BuzzerToneStep table (@p repeat passes, 0 ⇒ infinite). */
+  void playTones(const BuzzerToneStep* steps, uint32_t repeat);
+
+  /** @brief Gate a @p hz carrier with a ::BuzzerStep table (@p repeat passes, 0 ⇒ infinite). */
+  void playPattern(const uint16_t* steps, uint32_t repeat, uint16_t hz);
+
+  /** @brief Play @p preset: its tone table if it has one (see presetTones()), else its step table gating @p hz. */
+  void playPreset(BuzzerPreset preset, uint32_t repeat, uint16_t hz);
+
+  /** @brief Silence. */
+  void stop() { _mode = Mode::Idle; _inc = 0; _phase = 0; }
+
+  bool isBusy() const { return _mode != Mode::Idle; }
+
+  // -------------------- Generator --------------------
+  /** @brief Advance one sample. @return output level (true = HIGH). */
+  inline bool tick() {
+    _phase += _inc;
+    if (--_ctrlLeft == 0) _control();
+    return (_phase & 0x80000000UL) != 0;
+  }
+
+  /** @brief Phase increment of @p hz at the current tick rate. */
+  uint32_t hzToInc(uint16_t hz) const {
+    const uint64_t inc = ((uint64_t)hz * _incPerHz) >> 8;
+    return inc < 0x80000000ULL ? (uint32_t)inc : 0x7FFFFFFFUL;  // clamp at Nyquist
+  }
+
+  /** @brief Built-in tone table of @p preset (swept Alarm, two-note Success), nullptr if none. */
+  static const BuzzerToneStep* presetTones(BuzzerPreset preset);
+
+private:
+  enum class Mode : uint8_t { Idle = 0, Tone, Steps, Gate };
+  enum class Sweep : uint8_t { None = 0, Linear, Exp };
+
+  void _control();
+  bool _nextToneStep();
+  static uint32_t _pitchToInc(int32_t pitch);
+  static int32_t  _incToPitch(uint32_t inc);
+
+  // ---- generator ----
+  uint32_t _phase = 0;
+  uint32_t _inc = 0;           ///< phase step per tick (2^32 = one period)
+  uint32_t _incPerHz = 0;      ///< 2^40 / SAMPLE_HZ (Q8)
+  uint16_t _ctrlPeriod = 1;    ///< ticks per control step (1 ms)
+  uint16_t _ctrlLeft = 1;
+  Mode     _mode = Mode::Idle;
+
+  // ---- tone table ----
+  const BuzzerToneStep* _steps = nullptr;
+  uint16_t _step = 0;          ///< index of the next entry
+  uint16_t _msLeft = 0;        ///< control steps left in the current entry
+  uint32_t _repeatRemain = 0;  ///< remaining passes; 0 ⇒ infinite
+  Sweep    _sweep = Sweep::None;
+  int32_t  _pitch = 0;         ///< Exp sweep: log2(_inc), Q16
+  int32_t  _delta = 0;         ///< per-ms increment (Linear) or pitch (Exp) step
+
+  // ---- gated step table (ms clock = control steps) ----
+  BuzzerEngine  _env;
+  unsigned long _ms = 0;
+  uint32_t      _carrierInc = 0;
+};
+
+/**
+ * @class PassiveBuzzer
+ * @brief Passive piezo on one pin, driven by ::BuzzerToneEngine from a timer interrupt.
+ *
+ * Commands from the main loop are posted to a one-slot mailbox that tick() picks up; a command
+ * not yet picked up is replaced by the next one. The pin idles LOW (no DC across the piezo).
+ */
+class PassiveBuzzer {
+public:
+  /** @struct ParametersStruct
+   *  @brief User-configurable parameters.
+   */
+  struct ParametersStruct {
+    int      PIN_NUM    = -1;    ///< GPIO pin number (>=0)
+    uint32_t SAMPLE_HZ  = 20000; ///< Rate at which tick() is called (1000..1000000)
+    uint16_t CARRIER_HZ = 2700;  ///< Tone of presets without a tone table (typical piezo resonance)
+  } parameters;
+
+  PassiveBuzzer() = default;
+
+  /** @brief Destructor: return the pin to INPUT if initialized. */
+  ~PassiveBuzzer();
+
+  /**
+   * @brief Set the pin to OUTPUT/LOW and the engine to SAMPLE_HZ. Call before starting the timer.
+   * @return false on invalid parameters (see lastError()).
+   */
+  bool init();
+
+  /** @brief Get last error. */
+  BuzzerError lastError() const { return _lastError; }
+
+  // -------------------- Commands (main loop) --------------------
+  /** @brief Continuous tone of @p hz (0 ⇒ stop). */
+  void tone(uint16_t hz) { _post(Cmd::Tone, nullptr, 0, hz); }
+
+  /** @brief Play a PROGMEM ::BuzzerToneStep table (@p repeat passes, 0 ⇒ infinite). */
+  void playTones(const BuzzerToneStep* steps, uint32_t repeat = 1) { _post(Cmd::Tones, steps, repeat, 0); }
+
+  /** @brief Play a preset: tone table where available, otherwise its timing on CARRIER_HZ. */
+  void playPreset(BuzzerPreset preset, uint32_t repeat = 1) {
+    _post(Cmd::Preset, nullptr, repeat, (uint16_t)preset);
+  }
+
+  /** @brief Play a ::BuzzerStep table on CARRIER_HZ (@p repeat passes, 0 ⇒ infinite). */
+  void playPattern(const uint16_t* steps, uint32_t repeat = 1) { _post(Cmd::Pattern, steps, repeat, 0); }
+
+  /** @brief Silence. */
+  void stop() { _post(Cmd::Stop, nullptr, 0, 0); }
+
+  /** @brief Whether a sound is playing or posted. */
+  bool isBusy() const { return __atomic_load_n(&_posted, __ATOMIC_ACQUIRE) || _engine.isBusy(); }
+
+  // -------------------- Timer interrupt --------------------
+  /** @brief One sample: pick up a posted command, advance the engine, write the pin on a level change. */
+  inline void tick() {
+    if (!_initFlag) return;
+    if (__atomic_load_n(&_posted, __ATOMIC_ACQUIRE)) _apply();
+    const bool level = _engine.tick();
+    if (level != _level) { _level = level; _gpio.write(level ? HIGH : LOW); }
+  }
+
+private:
+  enum class Cmd : uint8_t { Stop = 0, Tone, Tones, Preset, Pattern };
+
+  void _post(Cmd cmd, const void* table, uint32_t repeat, uint16_t arg);
+  void _apply();
+
+  BuzzerToneEngine  _engine;
+  BuzzerDefaultGpio _gpio;
+  bool        _level = false;
+  bool        _initFlag = false;
+  BuzzerError _lastError = BuzzerError::None;
+
+  // ---- mailbox (written by the main loop, read by tick()) ----
+  uint8_t     _posted = 0;
+  Cmd         _cmd = Cmd::Stop;
+  const void* _table = nullptr;
+  uint32_t    _repeat = 0;
+  uint16_t    _arg = 0;
+};
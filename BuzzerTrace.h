@@ -0,0 +1,106 @@
+#pragma once
+#include <Arduino.h>
+#include "BuzzerConfig.h"
+
+/**
+ * @file BuzzerTrace.h
+ * @brief Optional edge trace for Buzzer: a ring of 16-bit timestamp deltas, dumpable over Serial.
+ *
+ * Compiled in only with BUZZER_ENABLE_TRACE=1, set in BuzzerConfig.h or for the whole build like
+ * BUZZER_ENABLE_STATS (the ring changes the layout of Buzzer; a mismatch fails to link).
+ * Each output edge costs one clock read and one 2-byte store; the oldest entries are overwritten.
+ * BUZZER_TRACE_SIZE sets the ring length (power of two, default 64 entries = 128 bytes).
+ *
+ * Entry encoding (bit 15 = level, bits 14..0 = delta in timebase ticks):
+ * - level differs from the previous entry: an edge, delta ticks after the previous entry
+ * - level equals the previous entry: no edge, time advances by delta × 32768 ticks
+ *   (long gaps; at most a few such entries per edge)
+ *
+ * Dump format (Buzzer::dumpTrace()), oldest entry first:
+ * @code
+ * BZT1 ms 123456 5        <- magic, timebase (ms|us), time of the newest entry, entry count
+ * 8032 0064 8032 03B6 ... <- entries, 4 hex digits, 16 per line
+ * BZT END
+ * @endcode
+ * extras/host/trace_convert.cpp turns a dump into VCD and WAV files.
+ */
+
+/**
+ * @class BuzzerTrace
+ * @brief Fixed-size ring of output edges (used by Buzzer).
+ */
+class BuzzerTrace {
+  static_assert(BUZZER_TRACE_SIZE >= 2 && BUZZER_TRACE_SIZE <= 32768 &&
+                (BUZZER_TRACE_SIZE & (BUZZER_TRACE_SIZE - 1)) == 0,
+                "BUZZER_TRACE_SIZE must be a power of two in 2..32768");
+
+public:
+  static constexpr uint16_t LEVEL_BIT  = 0x8000; ///< Output level after the entry
+  static constexpr uint16_t DELTA_MASK = 0x7FFF; ///< Ticks since the previous entry
+  static constexpr uint8_t  LONG_SHIFT = 15;     ///< Scale of same-level (gap) entries
+
+  /** @brief Record the output going to @p on at @p now (ignored if the level does not change). */
+  inline void record(bool on, unsigned long now) {
+    if (on == _level) return;
+    uint32_t d = (uint32_t)(now - _last);
+    const uint16_t held = _level ? LEVEL_BIT : 0;
+    for (uint32_t hi = d >> LONG_SHIFT; hi > 0; ) {
+      const uint16_t chunk = hi > DELTA_MASK ? DELTA_MASK : (uint16_t)hi;
+      _push(held | chunk);
+      hi -= chunk;
+    }
+    _push((on ? LEVEL_BIT : 0) | (uint16_t)(d & DELTA_MASK));
+    _last = now;
+    _level = on;
+  }
+
+  /** @brief Forget all entries; the output is @p on from @p now on. */
+  void reset(bool on, unsigned long now) {
+    _head = _count = 0;
+    _level = on;
+    _last = now;
+  }
+
+  /** @brief Number of entries held (≤ BUZZER_TRACE_SIZE). */
+  uint16_t size() const { return _count; }
+
+  /** @brief Entry @p i, 0 = oldest. */
+  uint16_t at(uint16_t i) const {
+    return _buf[(uint16_t)(_head - _count + i) & (BUZZER_TRACE_SIZE - 1)];
+  }
+
+  /** @brief Clock value of the newest entry. */
+  unsigned long lastAt() const { return _last; }
+
+  /** @brief Write the trace in the BZT1 text format (see file comment). */
+  void dump(Print& out, bool micros) const {
+    out.print(F("BZT1 "));
+    out.print(micros ? F("us ") : F("ms "));
+    out.print(_last);
+    out.print(' ');
+    out.println((unsigned long)_count);
+    for (uint16_t i = 0; i < _count; ++i) {
+      const uint16_t e = at(i);
+      for (int8_t s = 12; s >= 0; s -= 4) {
+        const uint8_t n = (e >> s) & 0x0F;
+        out.print((char)(n < 10 ? '0' + n : 'A' + n - 10));
+      }
+      if ((i & 15) == 15 || i + 1 == _count) out.println();
+      else                                    out.print(' ');
+    }
+    out.println(F("BZT END"));
+  }
+
+private:
+  inline void _push(uint16_t e) {
+    _buf[_head] = e;
+    _head = (uint16_t)((_head + 1) & (BUZZER_TRACE_SIZE - 1));
+    if (_count < BUZZER_TRACE_SIZE) _count++;
+  }
+
+  uint16_t      _buf[BUZZER_TRACE_SIZE];
+  uint16_t      _head = 0;
+  uint16_t      _count = 0;
+  bool          _level = false;
+  unsigned long _last = 0;
+};
@@ -0,0 +1,54 @@
+#include "BuzzerVolume.h"
+
+VolumeBuzzer::~VolumeBuzzer() {
+  if (_initFlag && parameters.PIN_NUM >= 0) {
+    pinMode(parameters.PIN_NUM, INPUT);
+  }
+}
+
+bool VolumeBuzzer::init() {
+  _initFlag  = false;
+  _lastError = BuzzerError::None;
+
+  if (parameters.PIN_NUM < 0 || !_gpio.attach((uint8_t)parameters.PIN_NUM)) {
+    _lastError = BuzzerError::InvalidPin;
+    return false;
+  }
+  if (parameters.ACTIVE_MODE > 1) {
+    _lastError = BuzzerError::InvalidActiveMode;
+    return false;
+  }
+
+#if defined(digitalPinHasPWM)
+  _hwPwm = digitalPinHasPWM(parameters.PIN_NUM);
+#else
+  _hwPwm = false;
+#endif
+
+  pinMode(parameters.PIN_NUM, OUTPUT);
+  digitalWrite(parameters.PIN_NUM, parameters.ACTIVE_MODE ? LOW : HIGH);
+  _engine.reset();
+  _level = false;
+  _acc = 0;
+  __atomic_store_n(&_duty, (uint8_t)0, __ATOMIC_RELAXED);
+
+  _initFlag = true;
+  return true;
+}
+
+void VolumeBuzzer::update() {
+  if (!_initFlag) return;
+  const unsigned long now = _engine.now();
+  if (_engine.isDue(now)) {
+    const unsigned long edge = _engine.deadline();
+    _engine.advance(now);
+    if (_engine.isOn()) _stepStart = edge;   // each ON step restarts the envelope, from its scheduled start
+  }
+  _setDuty(_engine.isOn() ? _envelope.at(now - _stepStart) : 0);
+}
+
+void VolumeBuzzer::_setDuty(uint8_t duty) {
+  if (duty == __atomic_load_n(&_duty, __ATOMIC_RELAXED)) return;
+  __atomic_store_n(&_duty, duty, __ATOMIC_RELAXED);
+  if (_hwPwm) analogWrite(parameters.PIN_NUM, parameters.ACTIVE_MODE ? duty : (uint8_t)(255 - duty));
+}
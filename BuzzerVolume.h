@@ -0,0 +1,180 @@
+#pragma once
+#include <Arduino.h>
+#include "Buzzer.h"
+
+/**
+ * @file BuzzerVolume.h
+ * @brief Loudness control for active buzzers: a PWM duty shaped by an envelope over each ON step.
+ *
+ * An active buzzer sounds at its own frequency whenever it is powered; chopping its supply with
+ * a fast PWM lowers the loudness. ::VolumeBuzzer plays the usual blink, preset, pattern and Morse
+ * timing (::BuzzerEngine) and, during every ON step, drives the duty given by a ::BuzzerEnvelope:
+ * a ramp from 0 to `peak` over `attackMs`, then to `level` over `decayMs`, then `level` until the
+ * step ends. OFF steps are silent.
+ *
+ * Output:
+ * - pins with hardware PWM (digitalPinHasPWM()): analogWrite() whenever the duty changes;
+ * - other pins: soft PWM, by calling pwmTick() from a timer interrupt (10..40 kHz). It is a
+ *   first-order sigma-delta (one 8-bit add per tick), so the switching energy sits near the tick
+ *   rate instead of an audible tick/256 PWM period.
+ *
+ * update() recomputes the duty, so envelopes are as smooth as the loop is frequent.
+ *
+ * @code
+ * VolumeBuzzer vb;                              // parameters.PIN_NUM = 9 (PWM on Uno), ACTIVE_MODE = 1
+ * BuzzerEnvelope night;  night.peak = night.level = 40;
+ * BuzzerEnvelope swell;  swell.attackMs = 300; swell.decayMs = 200; swell.level = 120;
+ *
+ * vb.setEnvelope(isNight ? night : swell);
+ * vb.playPreset(BuzzerPreset::Alarm, 0);
+ * void loop() { vb.update(); }
+ * @endcode
+ */
+
+/**
+ * @struct BuzzerEnvelope
+ * @brief Duty (0..255) over one ON step: attack to @ref peak, decay to @ref level, hold.
+ */
+struct BuzzerEnvelope {
+  uint16_t attackMs = 0;   ///< 0 ⇒ start at peak
+  uint16_t decayMs  = 0;   ///< 0 ⇒ jump to level after the attack
+  uint8_t  peak  = 255;    ///< Duty at the end of the attack
+  uint8_t  level = 255;    ///< Duty held after the decay
+
+  /** @brief Duty @p ms after the start of an ON step. */
+  uint8_t at(uint32_t ms) const {
+    if (ms < attackMs) return (uint8_t)((uint32_t)peak * ms / attackMs);
+    ms -= attackMs;
+    if (ms < decayMs) return (uint8_t)(peak + ((int32_t)level - peak) * (int32_t)ms / (int32_t)decayMs);
+    return level;
+  }
+};
+
+/**
+ * @class VolumeBuzzer
+ * @brief Active buzzer with envelope-controlled loudness (hardware or soft PWM).
+ */
+class VolumeBuzzer {
+public:
+  /** @struct ParametersStruct
+   *  @brief User-configurable parameters.
+   */
+  struct ParametersStruct {
+    int     PIN_NUM     = -1;  ///< GPIO pin number (>=0)
+    uint8_t ACTIVE_MODE = 0;   ///< 1 ⇒ active-HIGH, 0 ⇒ active-LOW (same default as Buzzer)
+  } parameters;
+
+  VolumeBuzzer() = default;
+
+  /** @brief Destructor: return the pin to INPUT if initialized. */
+  ~VolumeBuzzer();
+
+  /**
+   * @brief Set the pin to OUTPUT/OFF and pick hardware or soft PWM.
+   * @return false on invalid parameters (see lastError()).
+   */
+  bool init();
+
+  /** @brief Get last error. */
+  BuzzerError lastError() const { return _lastError; }
+
+  /** @brief Whether the pin uses analogWrite() (else pwmTick() must be called). */
+  bool hardwarePwm() const { return _hwPwm; }
+
+  // -------------------- Loudness --------------------
+  /** @brief Envelope applied to every ON step from now on (the running step picks it up too). */
+  void setEnvelope(const BuzzerEnvelope& envelope) { _envelope = envelope; }
+
+  /** @brief Flat envelope at @p level (0..255). */
+  void setVolume(uint8_t level) {
+    BuzzerEnvelope e;
+    e.peak = e.level = level;
+    _envelope = e;
+  }
+
+  const BuzzerEnvelope& envelope() const { return _envelope; }
+
+  /** @brief Duty currently driven (0..255, before ACTIVE_MODE inversion). */
+  uint8_t duty() const { return __atomic_load_n(&_duty, __ATOMIC_RELAXED); }
+
+  // -------------------- Sounds (non-blocking) --------------------
+  /** @brief Blink (@p repeat ON pulses, 0 ⇒ infinite). */
+  void startBlink(uint16_t on_ms, uint16_t off_ms, uint32_t repeat = 0) {
+    if (!_ready()) return;
+    const unsigned long now = _engine.now();
+    _engine.startBlink(on_ms, off_ms, repeat, now);
+    _started(now);
+  }
+
+  /** @brief Play a BuzzerPreset (@p repeat passes, 0 ⇒ infinite). */
+  void playPreset(BuzzerPreset preset, uint32_t repeat = 1) {
+    if (!_ready()) return;
+    const unsigned long now = _engine.now();
+    _engine.playPreset(preset, repeat, now);
+    _started(now);
+  }
+
+  /** @brief Play a PROGMEM ::BuzzerStep table (@p repeat passes, 0 ⇒ infinite). */
+  void playPattern(const uint16_t* steps, uint32_t repeat = 1) {
+    if (!_ready()) return;
+    const unsigned long now = _engine.now();
+    _engine.playPattern(steps, repeat, now);
+    _started(now);
+  }
+
+  /** @brief Key @p text in Morse code (see Buzzer::playMorse()). */
+  void playMorse(const char* text, uint8_t wpm = 12, uint32_t repeat = 1) {
+    if (!_ready()) return;
+    const unsigned long now = _engine.now();
+    _engine.playMorse(text, false, wpm, repeat, now);
+    _started(now);
+  }
+
+  /** @brief Stop and go silent. */
+  void stop() {
+    _engine.stop();
+    if (_initFlag) _setDuty(0);
+  }
+
+  bool isBusy() const { return _engine.isBusy(); }
+
+  // -------------------- Scheduler --------------------
+  /** @brief Advance the timing engine and recompute the duty. Call from loop(). */
+  void update();
+
+  /** @brief Soft-PWM step, from a timer interrupt; does nothing on hardware-PWM pins. */
+  inline void pwmTick() {
+    if (_hwPwm || !_initFlag) return;
+    const uint8_t d = __atomic_load_n(&_duty, __ATOMIC_RELAXED);
+    const uint8_t sum = (uint8_t)(_acc + d);
+    const bool on = d == 255 || sum < _acc;   // carry out of the accumulator ⇒ ON this tick
+    _acc = sum;
+    if (on != _level) {
+      _level = on;
+      _gpio.write(on == (parameters.ACTIVE_MODE != 0) ? HIGH : LOW);
+    }
+  }
+
+private:
+  bool _ready() {
+    if (_initFlag) return true;
+    _lastError = BuzzerError::NotInitialized;
+    return false;
+  }
+  void _started(unsigned long now) {
+    _stepStart = now;
+    _setDuty(_engine.isOn() ? _envelope.at(0) : 0);
+  }
+  void _setDuty(uint8_t duty);
+
+  BuzzerEngine      _engine;
+  BuzzerEnvelope    _envelope;
+  BuzzerDefaultGpio _gpio;
+  unsigned long _stepStart = 0;   ///< deadline at which the current ON step began
+  uint8_t       _duty = 0;        ///< shared with pwmTick()
+  uint8_t       _acc = 0;         ///< sigma-delta accumulator (pwmTick() only)
+  bool          _level = false;   ///< soft-PWM output state
+  bool          _hwPwm = false;
+  bool          _initFlag = false;
+  BuzzerError   _lastError = BuzzerError::None;
+};
@@ -0,0 +1,196 @@
+#pragma once
+#include <Arduino.h>
+#include "BuzzerGpio.h"
+#include "BuzzerEngine.h"
+#include "BuzzerPattern.h"
+
+/**
+ * @file StaticBuzzer.h
+ * @brief Buzzer with pin and polarity fixed at compile time.
+ *
+ * StaticBuzzer<PIN, ACTIVE_HIGH> runs the same ::BuzzerEngine (blink, presets, custom patterns)
+ * as the runtime-configured ::Buzzer, but keeps no configuration in RAM: the pin and polarity are
+ * template constants, pin validation is a static_assert, and each edge is a constant write
+ * (one sbi/cbi instruction on ATmega328P/168, see ::BuzzerStaticGpio).
+ *
+ * @code
+ * StaticBuzzer<8> bz;            // pin 8, active-HIGH
+ * StaticBuzzer<3, false> led;    // pin 3, active-LOW
+ *
+ * void setup() { bz.init(); bz.playPreset(BuzzerPreset::Heartbeat, true, 0); }
+ * void loop()  { bz.update(); }
+ * @endcode
+ */
+
+template <uint8_t SIZE> class BuzzerCommandQueue;
+
+/**
+ * @class StaticBuzzer
+ * @tparam PIN         GPIO pin number
+ * @tparam ACTIVE_HIGH true: active-HIGH, false: active-LOW
+ */
+template <uint8_t PIN, bool ACTIVE_HIGH = true>
+class StaticBuzzer {
+#if defined(NUM_DIGITAL_PINS)
+  static_assert(PIN < NUM_DIGITAL_PINS, "StaticBuzzer: PIN is not a digital pin on this board");
+#endif
+
+public:
+  StaticBuzzer() = default;
+
+  // -------------------- Init --------------------
+  /** @brief Set the pin to OUTPUT and OFF, reset the engine. Cannot fail. */
+  void init() {
+    pinMode(PIN, OUTPUT);
+    digitalWrite(PIN, _level(false)); // also detaches a PWM timer from the pin
+    _engine.reset();
+  }
+
+  // -------------------- Direct control --------------------
+  /** @brief Turn buzzer ON. */
+  void on()  { _write(true);  _engine.setOn(true); }
+  /** @brief Turn buzzer OFF. */
+  void off() { _write(false); _engine.setOn(false); }
+  /** @brief Software-tracked ON/OFF state. */
+  bool isOn() const { return _engine.isOn(); }
+
+  // -------------------- Non-blocking sounds --------------------
+  /** @brief Start non-blocking blink (@p repeat ON pulses, 0 ⇒ infinite). */
+  void startBlink(uint16_t on_ms, uint16_t off_ms, uint32_t repeat = 0) {
+    const bool was = _engine.isOn();
+    _engine.startBlink(on_ms, off_ms, repeat, _engine.now());
+    _sync(was);
+  }
+
+  /** @brief startBlink() with durations in microseconds (see Buzzer::startBlinkUs()). */
+  void startBlinkUs(uint32_t on_us, uint32_t off_us, uint32_t repeat = 0) {
+    const bool was = _engine.isOn();
+    _engine.startBlinkUs(on_us, off_us, repeat, _engine.now());
+    _sync(was);
+  }
+
+  /**
+   * @brief Play a BuzzerPreset, same parameters as Buzzer::playPreset().
+   * @param non_blocking true ⇒ run via update(); false ⇒ run here until done (calls yield())
+   * @param repeat       Passes (0 ⇒ infinite in non-blocking mode, once in blocking mode)
+   */
+  void playPreset(BuzzerPreset preset, bool non_blocking, uint32_t repeat = 1) {
+    if (!non_blocking && repeat == 0) repeat = 1;
+    const bool was = _engine.isOn();
+    _engine.playPreset(preset, repeat, _engine.now());
+    _sync(was);
+    if (non_blocking) return;
+    while (_engine.isBusy()) {
+      update();
+      yield();
+    }
+  }
+
+  /** @brief How long playPreset(@p preset, @p repeat) keeps the buzzer busy, in ms (IDLE_FOREVER if infinite). */
+  static constexpr unsigned long presetDurationMs(BuzzerPreset preset, uint32_t repeat = 1) {
+    return BuzzerPattern::presetDurationMs(preset, repeat);
+  }
+
+  /** @brief Play a PROGMEM ::BuzzerStep table non-blocking (@p repeat passes, 0 ⇒ infinite). */
+  void playPattern(const uint16_t* steps, uint32_t repeat = 1) {
+    const bool was = _engine.isOn();
+    _engine.playPattern(steps, repeat, _engine.now());
+    _sync(was);
+  }
+
+  /** @brief playPattern() with step durations in microseconds (see Buzzer::playPatternUs()). */
+  void playPatternUs(const uint16_t* steps, uint32_t repeat = 1) {
+    const bool was = _engine.isOn();
+    _engine.playPatternUs(steps, repeat, _engine.now());
+    _sync(was);
+  }
+
+  /** @brief Key Morse text non-blocking (see Buzzer::playMorse()). */
+  void playMorse(const char* text, uint8_t wpm = 12, uint32_t repeat = 1) {
+    const bool was = _engine.isOn();
+    _engine.playMorse(text, false, wpm, repeat, _engine.now());
+    _sync(was);
+  }
+
+  /** @brief playMorse() for a flash string. */
+  void playMorse(const __FlashStringHelper* text, uint8_t wpm = 12, uint32_t repeat = 1) {
+    const bool was = _engine.isOn();
+    _engine.playMorse(reinterpret_cast<const char*>(text), true, wpm, repeat, _engine.now());
+    _sync(was);
+  }
+
+  /** @brief Stop any activity and turn OFF. */
+  void stopAll() { _engine.stop(); _write(false); }
+
+  /// @return true if a non-blocking blink/preset is currently running.
+  bool isBusy() const { return _engine.isBusy(); }
+
+  // -------------------- Low-power idle --------------------
+  /** @brief Returned by msUntilNextEvent()/usUntilNextEvent() when nothing is scheduled. */
+  static constexpr unsigned long IDLE_FOREVER = BuzzerEngine::IDLE_FOREVER;
+
+  /**
+   * @brief Clock value (of the selected timebase) at which update() has work to do next.
+   * @note Meaningful only while isBusy(); use msUntilNextEvent() for a sleep budget (see Buzzer).
+   */
+  unsigned long nextEventAt() const { return _engine.deadline(); }
+
+  /**
+   * @brief How long the caller may sleep before the next update() is needed.
+   * @return Milliseconds (rounded down), 0 if an edge is due now, IDLE_FOREVER if idle
+   */
+  unsigned long msUntilNextEvent() const {
+    const unsigned long t = _engine.timeUntilNext(_engine.now());
+    if (t == IDLE_FOREVER || _engine.timebase() == BuzzerTimebase::Millis) return t;
+    return t / 1000UL;
+  }
+
+  /** @brief Like msUntilNextEvent(), in microseconds (ms timebase values are scaled ×1000). */
+  unsigned long usUntilNextEvent() const {
+    const unsigned long t = _engine.timeUntilNext(_engine.now());
+    if (t == IDLE_FOREVER || _engine.timebase() == BuzzerTimebase::Micros) return t;
+    return t * 1000UL;
+  }
+
+  // -------------------- Scheduler --------------------
+  /** @brief Select what happens when update() falls behind (default ::BuzzerCatchUp::Skip, see BuzzerEngine::setCatchUp()). */
+  void setCatchUp(BuzzerCatchUp policy) { _engine.setCatchUp(policy); }
+
+  /** @brief Schedule on millis() (default) or micros(); stops a running sound. */
+  void setTimebase(BuzzerTimebase timebase) {
+    const bool was = _engine.isOn();
+    _engine.setTimebase(timebase);
+    _sync(was);
+  }
+
+  /** @brief Advance the engine. Call from loop(). */
+  void update() {
+    if (!_engine.isBusy()) return;
+    update(_engine.now());
+  }
+
+  /** @brief Advance the engine using a caller-supplied clock value of the selected timebase. */
+  void update(unsigned long now) {
+    if (!_engine.isDue(now)) return;
+    const bool was = _engine.isOn();
+    _engine.advance(now);
+    _sync(was);
+  }
+
+  /** @brief Interrupt-driven entry, see Buzzer::tick(). */
+  template <uint8_t SIZE>
+  void tick(unsigned long now, BuzzerCommandQueue<SIZE>& queue) {
+    const bool was = _engine.isOn();
+    BuzzerCommand cmd;
+    while (queue.pop(cmd)) _engine.apply(cmd, now);
+    _sync(was);
+    update(now);
+  }
+
+private:
+  static constexpr uint8_t _level(bool on) { return (on == ACTIVE_HIGH) ? HIGH : LOW; }
+  static inline void _write(bool on) { BuzzerStaticGpio<PIN>::write(_level(on)); }
+  inline void _sync(bool was) { if (_engine.isOn() != was) _write(_engine.isOn()); }
+
+  BuzzerEngine _engine;
+};
@@ -0,0 +1,86 @@
+/**
+ * @file GpioBenchmark.ino
+ * @brief Before/after cost of one buzzer edge: digitalWrite() vs the cached port/mask path.
+ *
+ * Measured per ON+OFF pair:
+ *  - digitalWrite()       : what Buzzer::on()/off() used to call
+ *  - BuzzerPortGpio/PinGpio write(): the output policy alone (BuzzerDefaultGpio)
+ *  - Buzzer::on()/off()   : full public call (init check + state + policy)
+ *
+ * On AVR the counts are CPU cycles read from Timer1 running at F_CPU (no prescaler).
+ * Elsewhere they are nanoseconds derived from micros() over many iterations.
+ * Results are printed on Serial at 115200 baud.
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+static const int BUZZER_PIN = 7;   // change to your pin
+static const uint16_t N = 1000;    // pairs per measurement
+
+Buzzer bz;
+BuzzerDefaultGpio gpio;
+
+#if defined(__AVR__)
+// Cycles for N calls of body(), Timer1 at F_CPU; overflows are counted.
+template <typename F>
+static uint32_t measure(F body) {
+  uint8_t sreg = SREG;
+  cli();
+  const uint8_t tccr1a = TCCR1A, tccr1b = TCCR1B;
+  TCCR1A = 0; TCCR1B = _BV(CS10); TCNT1 = 0; TIFR1 = _BV(TOV1);
+  uint32_t overflows = 0;
+  for (uint16_t i = 0; i < N; ++i) {
+    body();
+    if (TIFR1 & _BV(TOV1)) { TIFR1 = _BV(TOV1); overflows++; }
+  }
+  const uint16_t t = TCNT1;
+  if (TIFR1 & _BV(TOV1)) { overflows++; }
+  TCCR1A = tccr1a; TCCR1B = tccr1b;
+  SREG = sreg;
+  return (overflows << 16) + t;
+}
+static const char* kUnit = "cycles";
+#else
+template <typename F>
+static uint32_t measure(F body) {
+  const unsigned long t0 = micros();
+  for (uint16_t i = 0; i < N; ++i) body();
+  return (micros() - t0) * 1000UL;  // ns for N pairs
+}
+static const char* kUnit = "ns";
+#endif
+
+static void report(const __FlashStringHelper* name, uint32_t total, uint32_t baseline) {
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print((float)(total - baseline) / N, 1);
+  Serial.print(' ');
+  Serial.print(kUnit);
+  Serial.println(F(" per ON+OFF pair"));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {}
+
+  bz.parameters.PIN_NUM = BUZZER_PIN;
+  bz.parameters.ACTIVE_MODE = 1;
+  if (!bz.init()) {
+    Serial.println(Buzzer::errorToCstr(bz.lastError()));
+    while (1) { delay(1000); }
+  }
+  gpio.attach(BUZZER_PIN);
+
+  // Loop overhead, subtracted from every result.
+  const uint32_t empty = measure([] { __asm__ __volatile__("" ::: "memory"); });
+
+  report(F("digitalWrite()     "), measure([] { digitalWrite(BUZZER_PIN, HIGH); digitalWrite(BUZZER_PIN, LOW); }), empty);
+  report(F("policy write()     "), measure([] { gpio.write(HIGH); gpio.write(LOW); }), empty);
+  report(F("Buzzer::on()/off() "), measure([] { bz.on(); bz.off(); }), empty);
+
+  Serial.print(F("output path: "));
+  Serial.println(BUZZER_GPIO_PORT ? F("cached port/mask") : F("digitalWrite()"));
+}
+
+void loop() {}
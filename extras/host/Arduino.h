@@ -0,0 +1,179 @@
+#pragma once
+/**
+ * @file Arduino.h
+ * @brief Host-side (Linux) stand-in for the Arduino core, used to run the Buzzer library off-target.
+ *
+ * - Virtual clock: millis()/micros() read sim::nowUs(); delay()/delayMicroseconds() advance it,
+ *   and so does yield() (by SIM_YIELD_US), so that busy-wait loops terminate.
+ * - GPIO: pinMode()/digitalWrite() are recorded in sim::state() with the virtual timestamp;
+ *   analogWrite() values are kept per pin (Uno PWM pins, see digitalPinHasPWM()).
+ *   Pins are grouped 8 per simulated port register (digitalPinToPort()/portOutputRegister()),
+ *   so port-level writes are reflected in the pin levels but not in the event log.
+ * - PROGMEM helpers map to plain memory reads; Print and Stream are minimal base classes for
+ *   output sinks and byte sources.
+ *
+ * Only the subset of the core used by this library is provided.
+ * Not for use on a real board: the library directory must never be put on the include path
+ * together with this folder when building for hardware.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+// -------------------- Core constants --------------------
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+// -------------------- Flash access --------------------
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)  (*(const void* const*)(addr))
+
+class __FlashStringHelper;
+#define F(str) (reinterpret_cast<const __FlashStringHelper*>(str))
+
+#ifndef SIM_NUM_PINS
+#define SIM_NUM_PINS 64
+#endif
+#define NUM_DIGITAL_PINS SIM_NUM_PINS
+
+#ifndef SIM_YIELD_US
+#define SIM_YIELD_US 10
+#endif
+#define NOT_A_PIN  0
+#define NOT_A_PORT 0
+
+// Ports are 8-bit AVR-style registers with no interrupts: BuzzerGpio.h may use them off AVR.
+#define BUZZER_GPIO_PORT_HOST 1
+
+namespace sim {
+
+/** @brief One recorded GPIO call. */
+struct PinEvent {
+  uint64_t us;     ///< Virtual time of the call (µs)
+  uint8_t  pin;    ///< Pin number
+  uint8_t  value;  ///< Level written (digitalWrite) or mode set (pinMode)
+  bool     isMode; ///< true for pinMode(), false for digitalWrite()
+};
+
+/** @brief Complete simulator state (single global instance). */
+struct State {
+  uint64_t nowUs = 0;               ///< Virtual clock
+  bool     record = true;           ///< Append GPIO calls to @ref events
+  std::vector<PinEvent> events;     ///< Recorded GPIO calls (when @ref record)
+  uint8_t  port[(SIM_NUM_PINS + 7) / 8] = {}; ///< Output registers, bit (pin % 8) of port (pin / 8)
+  uint8_t  mode[SIM_NUM_PINS]  = {};
+  uint8_t  analog[SIM_NUM_PINS] = {}; ///< Last analogWrite() value per pin
+  uint32_t digitalWriteCalls = 0;
+  uint32_t analogWriteCalls = 0;
+  uint32_t pinModeCalls = 0;
+};
+
+inline State& state() { static State s; return s; }
+
+/** @brief Reset clock, pins, counters and the event log. */
+inline void reset() { state() = State(); }
+
+inline uint64_t nowUs() { return state().nowUs; }
+inline void setUs(uint64_t us) { state().nowUs = us; }
+inline void setMs(uint64_t ms) { state().nowUs = ms * 1000ULL; }
+inline void advanceUs(uint64_t us) { state().nowUs += us; }
+inline void advanceMs(uint64_t ms) { state().nowUs += ms * 1000ULL; }
+
+/** @brief Current level of @p pin as last written. */
+inline uint8_t pinLevel(uint8_t pin) {
+  return (pin < SIM_NUM_PINS && (state().port[pin / 8] & (1u << (pin % 8)))) ? HIGH : LOW;
+}
+
+} // namespace sim
+
+// -------------------- Time --------------------
+inline unsigned long micros() { return (unsigned long)sim::state().nowUs; }
+inline unsigned long millis() { return (unsigned long)(sim::state().nowUs / 1000ULL); }
+inline void delay(unsigned long ms) { sim::advanceMs(ms); }
+inline void delayMicroseconds(unsigned int us) { sim::advanceUs(us); }
+inline void yield() { sim::advanceUs(SIM_YIELD_US); }
+
+// -------------------- GPIO --------------------
+inline void pinMode(uint8_t pin, uint8_t mode) {
+  sim::State& s = sim::state();
+  s.pinModeCalls++;
+  if (pin < SIM_NUM_PINS) s.mode[pin] = mode;
+  if (s.record) s.events.push_back({s.nowUs, pin, mode, true});
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t val) {
+  sim::State& s = sim::state();
+  s.digitalWriteCalls++;
+  if (pin < SIM_NUM_PINS) {
+    if (val) s.port[pin / 8] |= (uint8_t)(1u << (pin % 8));
+    else     s.port[pin / 8] &= (uint8_t)~(1u << (pin % 8));
+  }
+  if (s.record) s.events.push_back({s.nowUs, pin, (uint8_t)(val ? HIGH : LOW), false});
+}
+
+// Port numbers start at 1 so that NOT_A_PIN (0) stays invalid.
+inline uint8_t digitalPinToPort(uint8_t pin) { return pin < SIM_NUM_PINS ? (uint8_t)(pin / 8 + 1) : NOT_A_PIN; }
+inline uint8_t digitalPinToBitMask(uint8_t pin) { return (uint8_t)(1u << (pin % 8)); }
+inline volatile uint8_t* portOutputRegister(uint8_t port) { return &sim::state().port[port - 1]; }
+
+inline int digitalRead(uint8_t pin) { return sim::pinLevel(pin); }
+
+// Hardware PWM on the Uno pins (3, 5, 6, 9, 10, 11); values are stored, not simulated as a waveform.
+#define digitalPinHasPWM(p) ((p) == 3 || (p) == 5 || (p) == 6 || (p) == 9 || (p) == 10 || (p) == 11)
+
+inline void analogWrite(uint8_t pin, int val) {
+  sim::State& s = sim::state();
+  s.analogWriteCalls++;
+  if (pin < SIM_NUM_PINS) s.analog[pin] = (uint8_t)(val < 0 ? 0 : val > 255 ? 255 : val);
+}
+
+// -------------------- Print --------------------
+#define DEC 10
+#define HEX 16
+
+/** @brief Minimal Print: subclasses implement write(uint8_t). */
+class Print {
+public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t c) = 0;
+  size_t write(const char* s) { size_t n = 0; while (*s) n += write((uint8_t)*s++); return n; }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned long v, int base = DEC) {
+    char buf[8 * sizeof(unsigned long) + 1];
+    char* p = buf + sizeof(buf);
+    *--p = 0;
+    do { const unsigned d = (unsigned)(v % (unsigned)base); *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10); v /= (unsigned)base; } while (v);
+    return write(p);
+  }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC) {
+    if (v < 0 && base == DEC) return print('-') + print((unsigned long)-v, base);
+    return print((unsigned long)v, base);
+  }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+
+  size_t println() { return write((uint8_t)'\r') + write((uint8_t)'\n'); }
+  template <typename T> size_t println(const T& v) { return print(v) + println(); }
+  template <typename T> size_t println(const T& v, int base) { return print(v, base) + println(); }
+};
+
+// -------------------- Stream --------------------
+/** @brief Minimal Stream: non-blocking byte source on top of Print. */
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
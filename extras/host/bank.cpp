@@ -0,0 +1,107 @@
+/**
+ * @file bank.cpp
+ * @brief Self-check and benchmark of BuzzerBank: batched port writes vs one update() per buzzer.
+ *
+ * 16 buzzers on pins 8..23 (two simulated ports, a few active-LOW) play every preset and some
+ * blinks for 20 simulated seconds. The run is done once with N individual update() calls and once
+ * with one BuzzerBank<16>::update() per step; both must produce identical port contents at every
+ * step. The second table reports host nanoseconds per step for both ways.
+ *
+ * Build (port registers are needed for batching): see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerBank.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#if !BUZZER_GPIO_PORT
+#error "build with -DBUZZER_GPIO_PORT=1"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint8_t  kCount = 16;
+constexpr uint8_t  kFirstPin = 8;
+constexpr uint32_t kSimMs = 20000;
+
+void start(Buzzer (&bz)[kCount]) {
+  static const BuzzerPreset kPresets[] = {
+    BuzzerPreset::Init, BuzzerPreset::Stop, BuzzerPreset::Warning1, BuzzerPreset::Warning2,
+    BuzzerPreset::Warning3, BuzzerPreset::Heartbeat, BuzzerPreset::ErrorAlert, BuzzerPreset::Success,
+    BuzzerPreset::Alarm, BuzzerPreset::MorseSOS,
+  };
+  for (uint8_t i = 0; i < kCount; ++i) {
+    bz[i].parameters.PIN_NUM = (uint8_t)(kFirstPin + i);
+    bz[i].parameters.ACTIVE_MODE = (i % 5) != 4;
+    bz[i].init();
+    if (i < 10) bz[i].playPreset(kPresets[i], true, 0);
+    else        bz[i].startBlink((uint16_t)(50 + 25 * i), (uint16_t)(100 + 10 * i), 0);
+  }
+}
+
+/** @brief Port bytes of pins 8..23 after every 1 ms step; @p step services all buzzers once. */
+template <typename Step>
+std::vector<uint16_t> run(Step step) {
+  std::vector<uint16_t> levels;
+  levels.reserve(kSimMs);
+  for (uint32_t ms = 0; ms < kSimMs; ++ms) {
+    sim::advanceMs(1);
+    step();
+    levels.push_back((uint16_t)(sim::state().port[1] | sim::state().port[2] << 8));
+  }
+  return levels;
+}
+
+template <typename Step>
+double nsPerStep(Step step) {
+  sim::state().record = false;
+  const Clock::time_point t0 = Clock::now();
+  for (uint32_t ms = 0; ms < kSimMs; ++ms) { sim::advanceMs(1); step(); }
+  return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / kSimMs;
+}
+
+} // namespace
+
+int main() {
+  std::vector<uint16_t> single, batched;
+  double singleNs, batchedNs;
+  uint8_t ports;
+
+  {
+    sim::reset();
+    Buzzer bz[kCount];
+    start(bz);
+    auto step = [&] { for (Buzzer& b : bz) b.update(); };
+    single = run(step);
+    singleNs = nsPerStep(step);
+  }
+  {
+    sim::reset();
+    Buzzer bz[kCount];
+    start(bz);
+    BuzzerBank<kCount> bank;
+    for (Buzzer& b : bz) bank.add(b);
+    ports = bank.portCount();
+    auto step = [&] { bank.update(); };
+    batched = run(step);
+    batchedNs = nsPerStep(step);
+  }
+
+  uint32_t changes = 0;
+  for (size_t i = 1; i < single.size(); ++i) changes += single[i] != single[i - 1];
+  const bool same = single == batched;
+
+  std::printf("%u buzzers on %u ports, %u ms: port contents %s (%u steps with edges)  %s\n",
+              (unsigned)kCount, (unsigned)ports, (unsigned)kSimMs, same ? "identical" : "DIFFER",
+              (unsigned)changes, same ? "PASS" : "FAIL");
+  std::printf("\n%-24s %10s\n", "per 1 ms step", "ns");
+  std::printf("%-24s %10.1f\n", "16 x Buzzer::update()", singleNs);
+  std::printf("%-24s %10.1f\n", "BuzzerBank<16>::update()", batchedNs);
+  return same ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file bench_update.cpp
+ * @brief Host micro-benchmark: cost per Buzzer::update() call for every BuzzerPreset and startBlink.
+ *
+ * For each pattern two numbers are reported:
+ *  - idle: update() while nothing is due (clock frozen between calls)
+ *  - due : update() calls that produced an edge (virtual clock stepped 1 ms per call)
+ *
+ * A second table compares N individual update() calls with one BuzzerGroup<N>::update().
+ *
+ * GPIO recording is disabled during the measurement, so digitalWrite() costs only the mock's
+ * bookkeeping. Build once with -DBUZZER_GPIO_PORT=0 and once with -DBUZZER_GPIO_PORT=1 to compare
+ * the digitalWrite() and cached port/mask output paths. Numbers are host nanoseconds; use them to
+ * compare patterns and revisions, not as absolute MCU timings (examples/GpioBenchmark measures
+ * cycles on the board).
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerGroup.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int      kPin        = 8;
+constexpr uint32_t kIdleCalls  = 2000000;
+constexpr uint32_t kSimMs      = 60000;   // virtual time covered by the "due" measurement
+
+struct Result {
+  double   idleNs;
+  double   dueNs;
+  uint32_t dueCalls;
+};
+
+double nsBetween(Clock::time_point a, Clock::time_point b) {
+  return std::chrono::duration<double, std::nano>(b - a).count();
+}
+
+// Cost of the timing bracket itself, subtracted from per-call samples.
+double timerOverheadNs() {
+  const int n = 100000;
+  double total = 0;
+  for (int i = 0; i < n; ++i) {
+    const Clock::time_point t0 = Clock::now();
+    const Clock::time_point t1 = Clock::now();
+    total += nsBetween(t0, t1);
+  }
+  return total / n;
+}
+
+template <typename Start>
+Result measure(Buzzer& bz, Start start, double overheadNs) {
+  Result r{};
+
+  // idle: one deadline in the future, clock frozen
+  sim::setMs(1000);
+  start();
+  const Clock::time_point t0 = Clock::now();
+  for (uint32_t i = 0; i < kIdleCalls; ++i) bz.update();
+  r.idleNs = nsBetween(t0, Clock::now()) / kIdleCalls;
+
+  // due: advance 1 ms per call, time only the calls that changed the pin level
+  sim::setMs(1000);
+  start();
+  double dueTotal = 0;
+  for (uint32_t ms = 0; ms < kSimMs; ++ms) {
+    sim::advanceMs(1);
+    const uint8_t levelBefore = sim::pinLevel(kPin);
+    const Clock::time_point a = Clock::now();
+    bz.update();
+    const Clock::time_point b = Clock::now();
+    if (sim::pinLevel(kPin) != levelBefore) {
+      dueTotal += nsBetween(a, b) - overheadNs;
+      r.dueCalls++;
+    }
+  }
+  r.dueNs = r.dueCalls ? dueTotal / r.dueCalls : 0.0;
+  bz.stopAll();
+  return r;
+}
+
+void print(const char* name, const Result& r) {
+  std::printf("%-12s %10.2f %10.2f %10u\n", name, r.idleNs, r.dueNs, (unsigned)r.dueCalls);
+}
+
+constexpr uint8_t kGroupSize = 12;
+
+// Idle and per-simulated-ms cost of servicing kGroupSize heartbeats, individually vs grouped.
+void benchGroup() {
+  Buzzer bz[kGroupSize];
+  BuzzerGroup<kGroupSize> group;
+  sim::setMs(1000);
+  for (uint8_t i = 0; i < kGroupSize; ++i) {
+    bz[i].parameters.PIN_NUM = 20 + i;
+    bz[i].parameters.ACTIVE_MODE = 1;
+    bz[i].init();
+    bz[i].playPreset(BuzzerPreset::Heartbeat, true, 0);
+    sim::advanceMs(37); // spread the phases
+    group.add(bz[i]);
+  }
+
+  const Clock::time_point t0 = Clock::now();
+  for (uint32_t i = 0; i < kIdleCalls / kGroupSize; ++i) {
+    for (uint8_t k = 0; k < kGroupSize; ++k) bz[k].update();
+  }
+  const double loopIdle = nsBetween(t0, Clock::now()) / (kIdleCalls / kGroupSize);
+
+  const Clock::time_point t1 = Clock::now();
+  for (uint32_t i = 0; i < kIdleCalls / kGroupSize; ++i) group.update();
+  const double groupIdle = nsBetween(t1, Clock::now()) / (kIdleCalls / kGroupSize);
+
+  const Clock::time_point t2 = Clock::now();
+  for (uint32_t ms = 0; ms < kSimMs; ++ms) {
+    sim::advanceMs(1);
+    for (uint8_t k = 0; k < kGroupSize; ++k) bz[k].update();
+  }
+  const double loopRun = nsBetween(t2, Clock::now()) / kSimMs;
+
+  const Clock::time_point t3 = Clock::now();
+  for (uint32_t ms = 0; ms < kSimMs; ++ms) {
+    sim::advanceMs(1);
+    group.update();
+  }
+  const double groupRun = nsBetween(t3, Clock::now()) / kSimMs;
+
+  std::printf("\n%u x Heartbeat   %10s %10s\n", (unsigned)kGroupSize, "idle ns", "per-ms ns");
+  std::printf("%-17s %10.2f %10.2f\n", "update() each", loopIdle, loopRun);
+  std::printf("%-17s %10.2f %10.2f\n", "BuzzerGroup", groupIdle, groupRun);
+}
+
+} // namespace
+
+int main() {
+  sim::reset();
+  sim::state().record = false;
+
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  if (!bz.init()) {
+    std::printf("init failed: %s\n", Buzzer::errorToCstr(bz.lastError()));
+    return 1;
+  }
+
+  const double overhead = timerOverheadNs();
+  std::printf("output path: %s\n", BUZZER_GPIO_PORT ? "cached port/mask" : "digitalWrite()");
+  std::printf("timer overhead subtracted: %.2f ns\n\n", overhead);
+  std::printf("%-12s %10s %10s %10s\n", "pattern", "idle ns", "due ns", "due calls");
+
+  static const struct { const char* name; BuzzerPreset preset; } kPresets[] = {
+    {"Init", BuzzerPreset::Init},           {"Stop", BuzzerPreset::Stop},
+    {"Warning1", BuzzerPreset::Warning1},   {"Warning2", BuzzerPreset::Warning2},
+    {"Warning3", BuzzerPreset::Warning3},   {"Heartbeat", BuzzerPreset::Heartbeat},
+    {"ErrorAlert", BuzzerPreset::ErrorAlert}, {"Success", BuzzerPreset::Success},
+    {"Alarm", BuzzerPreset::Alarm},         {"MorseSOS", BuzzerPreset::MorseSOS},
+  };
+
+  for (const auto& p : kPresets) {
+    print(p.name, measure(bz, [&] { bz.playPreset(p.preset, true, 0); }, overhead));
+  }
+  print("Blink", measure(bz, [&] { bz.startBlink(5, 5, 0); }, overhead));
+
+  benchGroup();
+
+  return 0;
+}
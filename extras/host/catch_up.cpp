@@ -0,0 +1,91 @@
+/**
+ * @file catch_up.cpp
+ * @brief Self-check: Heartbeat phase over one simulated hour with a late, stalling main loop.
+ *
+ * The loop calls update() every 1..7 ms (random) and stalls for 3 s once a minute; a final 10 s
+ * of punctual 1 ms updates follows. For each ::BuzzerCatchUp policy the program reports:
+ *  - phase error: offset of the last rising edge from the nominal 1000 ms grid (must be 0)
+ *  - pulses: rising edges seen (3610 expected for a phase-locked heartbeat)
+ *  - short pulses: ON times below 40 ms, i.e. shortened beyond the loop's own 1..7 ms jitter
+ *    (replayed or compressed steps)
+ *  - Compress only: the shortest ON and OFF steps, which must keep at least half of 50 / 950 ms
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr int kPin = 8;
+
+bool run(const char* name, BuzzerCatchUp policy) {
+  sim::reset();
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  bz.setCatchUp(policy);
+  sim::state().events.clear();
+
+  const uint64_t t0 = sim::nowUs();
+  bz.playPreset(BuzzerPreset::Heartbeat, true, 0);
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> jitter(1, 7);
+  uint64_t nextStallMs = 60000;
+  while (sim::nowUs() - t0 < 3600ULL * 1000000ULL) {
+    sim::advanceMs(jitter(rng));
+    if (millis() >= nextStallMs) { sim::advanceMs(3000); nextStallMs += 60000; }
+    bz.update();
+  }
+  // Punctual loop: every policy must be back on the grid.
+  while (sim::nowUs() - t0 < 3610ULL * 1000000ULL) {
+    sim::advanceMs(1);
+    bz.update();
+  }
+
+  uint32_t pulses = 0, shortPulses = 0;
+  uint64_t lastRise = t0, lastFall = t0, minOn = UINT64_MAX, minOff = UINT64_MAX;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (e.isMode || e.pin != kPin) continue;
+    if (e.value == HIGH) {
+      if (pulses) minOff = std::min(minOff, e.us - lastFall);
+      pulses++;
+      lastRise = e.us;
+    } else {
+      if (e.us - lastRise < 40000) shortPulses++;
+      minOn = std::min(minOn, e.us - lastRise);
+      lastFall = e.us;
+    }
+  }
+  long phaseMs = (long)(((lastRise - t0) / 1000) % 1000);
+  if (phaseMs > 500) phaseMs -= 1000;
+
+  bool ok = phaseMs == 0;
+  std::printf("%-9s phase error %4ld ms   pulses %5u   short pulses %4u", name, phaseMs, (unsigned)pulses,
+              (unsigned)shortPulses);
+  if (policy == BuzzerCatchUp::Compress) {
+    ok = ok && minOn >= 25000 && minOff >= 475000;
+    std::printf("   shortest ON %2u ms, OFF %3u ms", (unsigned)(minOn / 1000), (unsigned)(minOff / 1000));
+  }
+  std::printf("  %s\n", ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+  failed += !run("Strict", BuzzerCatchUp::Strict);
+  failed += !run("Skip", BuzzerCatchUp::Skip);
+  failed += !run("Compress", BuzzerCatchUp::Compress);
+  std::printf("\n%s\n", failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file events.cpp
+ * @brief Self-check of Buzzer::setEventHook(): repeat/complete/edge events and chaining on Complete.
+ *
+ * - Stop preset ×3: two Repeat events at the pass boundaries, Complete when the last pass ends
+ * - 100/100 ms blink ×5 with edge events: On/Off at every scheduled edge, in update() order
+ * - a playlist chained from the Complete event: no gap between sounds, total time is the sum
+ *   of presetDurationMs()
+ * - the same events through BuzzerBank
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerBank.h"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr int kPin = 8;
+
+struct Log {
+  std::string text;   // one letter per event: R, +, -, C
+  std::vector<unsigned long> at;
+};
+
+void record(void* ctx, BuzzerEvent e) {
+  Log& log = *static_cast<Log*>(ctx);
+  log.text += e == BuzzerEvent::Repeat ? 'R' : e == BuzzerEvent::On ? '+' : e == BuzzerEvent::Off ? '-' : 'C';
+  log.at.push_back(millis());
+}
+
+void setup(Buzzer& bz, uint8_t pin = kPin) {
+  bz.parameters.PIN_NUM = pin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+}
+
+template <typename Step>
+void runMs(uint32_t ms, Step step) {
+  for (uint32_t t = 0; t < ms; ++t) { sim::advanceMs(1); step(); }
+}
+
+bool report(const char* name, const std::string& got, const std::string& want, bool extra = true) {
+  const bool ok = got == want && extra;
+  std::printf("%-28s %-24s %s\n", name, got.c_str(), ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+// Playlist chained from the Complete event.
+struct Playlist {
+  Buzzer* bz;
+  const BuzzerPreset* items;
+  uint8_t count;
+  uint8_t next;
+  unsigned long doneAt;
+};
+
+void playNext(void* ctx, BuzzerEvent e) {
+  Playlist& p = *static_cast<Playlist*>(ctx);
+  if (e != BuzzerEvent::Complete) return;
+  if (p.next < p.count) p.bz->playPreset(p.items[p.next++], true, 1);
+  else                  p.doneAt = millis();
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+
+  {
+    sim::reset();
+    Buzzer bz;
+    setup(bz);
+    Log log;
+    bz.setEventHook(record, &log);
+    bz.playPreset(BuzzerPreset::Stop, true, 3);
+    runMs(2000, [&] { bz.update(); });
+    const bool times = log.at.size() == 3 && log.at[0] == 400 && log.at[1] == 800 && log.at[2] == 1200;
+    failed += !report("Stop x3", log.text, "RRC", times);
+  }
+  {
+    sim::reset();
+    Buzzer bz;
+    setup(bz);
+    Log log;
+    bz.setEventHook(record, &log, true);
+    bz.startBlink(100, 100, 5);
+    runMs(2000, [&] { bz.update(); });
+    failed += !report("Blink 100/100 x5, edges", log.text, "-R+-R+-R+-R+-C");
+  }
+  {
+    sim::reset();
+    Buzzer bz;
+    setup(bz);
+    static const BuzzerPreset kList[] = { BuzzerPreset::Success, BuzzerPreset::Stop, BuzzerPreset::ErrorAlert };
+    Playlist p{&bz, kList, 3, 1, 0};
+    bz.setEventHook(playNext, &p);
+    bz.playPreset(kList[0], true, 1);
+    runMs(10000, [&] { bz.update(); });
+    unsigned long want = 0;
+    for (BuzzerPreset preset : kList) want += Buzzer::presetDurationMs(preset);
+    char got[32];
+    std::snprintf(got, sizeof(got), "done at %lu ms", p.doneAt);
+    failed += !report("Chained playlist", got, "done at " + std::to_string(want) + " ms");
+  }
+  {
+    sim::reset();
+    Buzzer a, b;
+    setup(a, kPin);
+    setup(b, kPin + 1);
+    Log la, lb;
+    a.setEventHook(record, &la);
+    b.setEventHook(record, &lb, true);
+    BuzzerBank<2> bank;
+    bank.add(a);
+    bank.add(b);
+    a.playPreset(BuzzerPreset::Stop, true, 2);
+    b.startBlink(50, 50, 2);
+    runMs(1000, [&] { bank.update(); });
+    failed += !report("BuzzerBank", la.text + " / " + lb.text, "RC / -R+-C");
+  }
+
+  std::printf("\n%s\n", failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file loop_budget.cpp
+ * @brief Host demo of the BUZZER_ENABLE_STATS counters: which presets a given loop() period can serve.
+ *
+ * Every preset (infinite) and a 100/900 ms blink run for 20 simulated seconds with update()
+ * called every 1, 3, 7 and 20 ms. For each run the table shows the counters of Buzzer::stats():
+ * deadline misses (more than BUZZER_STATS_MISS_US late), max/mean lateness and duty.
+ *
+ * Build (stats must be enabled for every file): see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+#include <cstdio>
+
+#if !BUZZER_ENABLE_STATS
+#error "build with -DBUZZER_ENABLE_STATS=1"
+#endif
+
+namespace {
+
+constexpr int kPin = 8;
+
+template <typename Start>
+void row(const char* name, Start start) {
+  std::printf("%-11s", name);
+  for (uint32_t period : {1u, 3u, 7u, 20u}) {
+    sim::reset();
+    Buzzer bz;
+    bz.parameters.PIN_NUM = kPin;
+    bz.parameters.ACTIVE_MODE = 1;
+    bz.init();
+    start(bz);
+    for (uint32_t t = 0; t < 20000; t += period) { sim::advanceMs(period); bz.update(); }
+
+    const BuzzerStats s = bz.stats();
+    std::printf(" | %5u %3u/%2u %4u", (unsigned)s.misses, (unsigned)s.maxLateness,
+                (unsigned)s.meanLateness(), (unsigned)s.dutyPermille());
+  }
+  std::printf("\n");
+}
+
+} // namespace
+
+int main() {
+  std::printf("%-11s", "loop period");
+  for (const char* p : {"1 ms", "3 ms", "7 ms", "20 ms"}) std::printf(" | %-16s", p);
+  std::printf("\n%-11s", "");
+  for (int i = 0; i < 4; ++i) std::printf(" | %5s %6s %4s", "miss", "max/mn", "duty");
+  std::printf("\n");
+
+  static const struct { const char* name; BuzzerPreset preset; } kPresets[] = {
+    {"Init", BuzzerPreset::Init},           {"Stop", BuzzerPreset::Stop},
+    {"Warning1", BuzzerPreset::Warning1},   {"Warning2", BuzzerPreset::Warning2},
+    {"Warning3", BuzzerPreset::Warning3},   {"Heartbeat", BuzzerPreset::Heartbeat},
+    {"ErrorAlert", BuzzerPreset::ErrorAlert}, {"Success", BuzzerPreset::Success},
+    {"Alarm", BuzzerPreset::Alarm},         {"MorseSOS", BuzzerPreset::MorseSOS},
+  };
+  for (const auto& p : kPresets) row(p.name, [&](Buzzer& bz) { bz.playPreset(p.preset, true, 0); });
+  row("Blink", [](Buzzer& bz) { bz.startBlink(100, 900, 0); });
+
+  std::printf("\nlateness in ms, duty in per mille of the 20 s run\n");
+  return 0;
+}
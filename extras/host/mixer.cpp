@@ -0,0 +1,131 @@
+/**
+ * @file mixer.cpp
+ * @brief Self-check of BuzzerMixer: OR / XOR / Priority of layers equals the combination of the
+ *        same sounds played alone, with polled and sleeping loops.
+ *
+ * Layer 0 plays a 500/4500 ms status blink, layer 1 a Heartbeat (OR, XOR) or two Alarm passes
+ * (Priority, so that the blink shows through afterwards). Each sound is also played alone on a
+ * plain Buzzer; the pin level of every millisecond must match the mixed rule. The sleeping loop
+ * jumps by msUntilNextEvent(); its wake-up count shows the mixer waking only on layer deadlines.
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerMixer.h"
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace {
+
+constexpr int      kPin = 8;
+constexpr uint32_t kSimMs = 20000;
+
+void setup(Buzzer& bz) {
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+}
+
+/** @brief Pin level at every millisecond, update() polled every 1 ms. */
+template <typename Update>
+std::vector<uint8_t> levels(Update update) {
+  std::vector<uint8_t> out;
+  out.reserve(kSimMs);
+  for (uint32_t t = 0; t < kSimMs; ++t) {
+    update();
+    out.push_back(sim::pinLevel(kPin));
+    sim::advanceMs(1);
+  }
+  return out;
+}
+
+/** @brief One sound alone on a plain Buzzer. */
+std::vector<uint8_t> alone(const std::function<void(Buzzer&)>& start) {
+  sim::reset();
+  Buzzer bz;
+  setup(bz);
+  start(bz);
+  return levels([&] { bz.update(); });
+}
+
+using LayerStart = std::function<void(BuzzerMixer<2>&)>;
+
+std::vector<uint8_t> mixed(BuzzerMix mix, const LayerStart& start) {
+  sim::reset();
+  Buzzer bz;
+  setup(bz);
+  BuzzerMixer<2> m(bz, mix);
+  start(m);
+  return levels([&] { m.update(); });
+}
+
+/** @brief Same run, sleeping on msUntilNextEvent(); returns the levels and counts wake-ups. */
+std::vector<uint8_t> sleeping(BuzzerMix mix, const LayerStart& start, uint32_t& wakeups) {
+  sim::reset();
+  Buzzer bz;
+  setup(bz);
+  BuzzerMixer<2> m(bz, mix);
+  start(m);
+  std::vector<uint8_t> out(kSimMs, LOW);
+  uint32_t t = 0;
+  wakeups = 0;
+  while (t < kSimMs) {
+    m.update();
+    ++wakeups;
+    const unsigned long sleep = m.msUntilNextEvent();
+    const uint32_t step = sleep == 0 ? 1 : sleep > kSimMs ? kSimMs : (uint32_t)sleep;
+    const uint32_t until = t + step > kSimMs ? kSimMs : t + step;
+    for (; t < until; ++t) out[t] = sim::pinLevel(kPin);
+    sim::setMs(t);
+  }
+  return out;
+}
+
+bool check(const char* name, BuzzerMix mix, const LayerStart& start, const std::function<uint8_t(uint32_t)>& rule) {
+  const std::vector<uint8_t> polled = mixed(mix, start);
+  uint32_t wakeups = 0;
+  const std::vector<uint8_t> slept = sleeping(mix, start, wakeups);
+  uint32_t bad = 0, on = 0;
+  for (uint32_t t = 0; t < kSimMs; ++t) {
+    const uint8_t want = rule(t);
+    bad += polled[t] != want;
+    on += want;
+  }
+  const bool ok = bad == 0 && slept == polled;
+  std::printf("%-9s ON %5u of %u ms, %u mismatches, sleeping loop %s with %4u wake-ups  %s\n", name,
+              (unsigned)on, (unsigned)kSimMs, (unsigned)bad, slept == polled ? "identical" : "DIFFERENT",
+              (unsigned)wakeups, ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+
+  const auto blink = alone([](Buzzer& bz) { bz.startBlink(500, 4500, 0); });
+  const auto pip   = alone([](Buzzer& bz) { bz.playPreset(BuzzerPreset::Heartbeat, true, 0); });
+  const auto alarm = alone([](Buzzer& bz) { bz.playPreset(BuzzerPreset::Alarm, true, 2); });
+
+  const LayerStart blinkPip = [](BuzzerMixer<2>& m) {
+    m.startBlink(0, 500, 4500, 0);
+    m.playPreset(1, BuzzerPreset::Heartbeat, 0);
+  };
+  const LayerStart blinkAlarm = [](BuzzerMixer<2>& m) {
+    m.startBlink(0, 500, 4500, 0);
+    m.playPreset(1, BuzzerPreset::Alarm, 2);
+  };
+  const uint32_t alarmEnd = Buzzer::presetDurationMs(BuzzerPreset::Alarm, 2);
+
+  failed += !check("Or", BuzzerMix::Or, blinkPip, [&](uint32_t t) { return (uint8_t)(blink[t] | pip[t]); });
+  failed += !check("Xor", BuzzerMix::Xor, blinkPip, [&](uint32_t t) { return (uint8_t)(blink[t] ^ pip[t]); });
+  failed += !check("Priority", BuzzerMix::Priority, blinkAlarm,
+                   [&](uint32_t t) { return t < alarmEnd ? alarm[t] : blink[t]; });
+
+  std::printf("\n%s\n", failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file morse.cpp
+ * @brief Host self-check of Buzzer::playMorse().
+ *
+ * Checks:
+ *  - playMorse("SOS") at 12 WPM keys exactly the edges of the MorseSOS preset
+ *  - an F() string, lowercase text and skipped characters key the same as plain uppercase
+ *  - element, letter, word and pass gaps are 1, 3, 7 and 7 units at 20 WPM (60 ms unit)
+ *  - text with nothing to key ("#%", spaces) stops the running sound, ON or OFF at the time
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace {
+
+constexpr int kPin = 8;
+
+// Edge times (ms from start) and levels of one non-blocking sound, played to the end (60 s at most).
+std::vector<std::pair<uint64_t, int>> edges(const std::function<void(Buzzer&)>& start) {
+  sim::reset();
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  sim::state().events.clear();
+  const uint64_t t0 = sim::nowUs();
+  start(bz);
+  for (uint32_t ms = 0; bz.isBusy() && ms < 60000; ++ms) { sim::advanceMs(1); bz.update(); }
+
+  std::vector<std::pair<uint64_t, int>> out;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (!e.isMode && e.pin == kPin) out.push_back({(e.us - t0) / 1000, e.value});
+  }
+  return out;
+}
+
+bool check(bool ok, const char* what) {
+  std::printf("%s  %s\n", ok ? "PASS" : "FAIL", what);
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  bool ok = true;
+
+  ok &= check(edges([](Buzzer& bz) { bz.playMorse("SOS"); }) ==
+              edges([](Buzzer& bz) { bz.playPreset(BuzzerPreset::MorseSOS, true, 1); }),
+              "playMorse(\"SOS\") matches the MorseSOS preset");
+
+  const auto plain = edges([](Buzzer& bz) { bz.playMorse("ID 42", 20); });
+  ok &= check(plain == edges([](Buzzer& bz) { bz.playMorse(F("id #42"), 20); }),
+              "F() string, lowercase and unknown characters key like plain text");
+
+  // "ET" twice at 20 WPM: E = dot, T = dash.
+  //   E on 0..60, letter gap 180, T on 240..420, pass gap 420 (60 + 360), E on 840.
+  const auto et = edges([](Buzzer& bz) { bz.playMorse("ET", 20, 2); });
+  const std::vector<std::pair<uint64_t, int>> want = {
+    {0, HIGH}, {60, LOW}, {240, HIGH}, {420, LOW}, {840, HIGH}, {900, LOW}, {1080, HIGH}, {1260, LOW}
+  };
+  ok &= check(et == want, "unit, letter and pass gaps at 20 WPM");
+
+  // Heartbeat is ON for 0..50 ms: replace it at 20 ms (ON) and at 500 ms (OFF).
+  bool stops = true;
+  for (const char* text : {"#%", "   ", ""}) {
+    for (uint64_t at : {20, 500}) {
+      const auto e = edges([&](Buzzer& bz) {
+        bz.playPreset(BuzzerPreset::Heartbeat, true, 0);
+        for (uint64_t ms = 0; ms < at; ++ms) { sim::advanceMs(1); bz.update(); }
+        bz.playMorse(text);
+        stops = stops && !bz.isBusy() && !bz.isOn();
+      });
+      stops = stops && !e.empty() && e.back().second == LOW && e.back().first <= at;
+    }
+  }
+  ok &= check(stops, "text with nothing to key stops the running sound");
+
+  std::printf("\n\"ID 42\" at 20 WPM:");
+  for (size_t i = 0; i + 1 < plain.size(); i += 2) {
+    std::printf("%s%llu", i % 16 ? " " : "\n  ", (unsigned long long)(plain[i + 1].first - plain[i].first));
+  }
+  std::printf("  (ms ON per element)\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file pattern_compile.cpp
+ * @brief Compile a text sequence (see stream_format.h) into a BZS1 stream for BuzzerStreamPlayer.
+ *
+ * Usage: pattern_compile <in.txt> <out.bzs>          binary, e.g. for an SD card
+ *        pattern_compile <in.txt> --c <name>         PROGMEM array on stdout, for BuzzerBlobStream
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include "stream_format.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv) {
+  const bool asC = argc == 4 && !std::strcmp(argv[2], "--c");
+  if (argc != 3 && !asC) {
+    std::fprintf(stderr, "usage: %s <in.txt> <out.bzs>\n       %s <in.txt> --c <name>\n", argv[0], argv[0]);
+    return 2;
+  }
+
+  std::string text, error;
+  std::vector<bzs::Step> steps;
+  if (!bzs::readFile(argv[1], text))        { std::fprintf(stderr, "cannot read %s\n", argv[1]); return 1; }
+  if (!bzs::compile(text, steps, error))    { std::fprintf(stderr, "%s: %s\n", argv[1], error.c_str()); return 1; }
+  const std::vector<uint8_t> bytes = bzs::encode(steps);
+
+  if (asC) {
+    std::fputs(bzs::toC(bytes, argv[3]).c_str(), stdout);
+    return 0;
+  }
+  if (!bzs::writeFile(argv[2], std::string(bytes.begin(), bytes.end()))) {
+    std::fprintf(stderr, "cannot write %s\n", argv[2]);
+    return 1;
+  }
+  uint64_t total = 0, on = 0;
+  for (const bzs::Step& s : steps) { total += s.ms; if (s.on) on += s.ms; }
+  std::fprintf(stderr, "%zu steps, %llu ms (ON %llu ms), %zu bytes\n", steps.size(),
+               (unsigned long long)total, (unsigned long long)on, bytes.size());
+  return 0;
+}
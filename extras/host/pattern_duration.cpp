@@ -0,0 +1,80 @@
+/**
+ * @file pattern_duration.cpp
+ * @brief Self-check of BuzzerPattern.h: compile-time durations match the simulated busy time.
+ *
+ * - every preset, played 3 times: Buzzer::presetDurationMs() vs the time isBusy() stays true
+ * - a pattern built with seq/repeat/interleave: P::duration vs the simulated pass, and its edges
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+#include <cstdio>
+
+namespace {
+
+using namespace BuzzerPattern;
+
+constexpr int kPin = 8;
+
+// ON rhythm 30/60/90 interleaved with OFF rhythm 20/40/80, twice, then a 500 ms pause.
+using Rhythm = seq<repeat<2, interleave<seq<tone<30>, tone<60>, tone<90>>, seq<gap<20>, gap<40>, gap<80>>>>,
+                   gap<500>>;
+static_assert(Rhythm::duration == 1140, "Rhythm duration");
+static_assert(Rhythm::size == 8, "Rhythm words: 6 steps, loop, gap");
+static_assert(Buzzer::presetDurationMs(BuzzerPreset::Warning1) == 4000, "Warning1 = 10 x (20 x 10 ms + 200 ms)");
+static_assert(Buzzer::presetDurationMs(BuzzerPreset::Alarm, 0) == Buzzer::IDLE_FOREVER, "infinite");
+
+/** @brief Start a sound at t = 0 and return how long (ms) isBusy() stays true; edges go to @p edges. */
+template <typename Start>
+unsigned long busyMs(Start start, std::vector<uint64_t>* edges = nullptr) {
+  sim::reset();
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  sim::state().events.clear();
+  start(bz);
+  unsigned long ms = 0;
+  while (bz.isBusy() && ms < 600000) { sim::advanceMs(1); ++ms; bz.update(); }
+  if (edges) {
+    for (const sim::PinEvent& e : sim::state().events) if (!e.isMode) edges->push_back(e.us / 1000);
+  }
+  return ms;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+
+  static const struct { const char* name; BuzzerPreset preset; } kPresets[] = {
+    {"Init", BuzzerPreset::Init},           {"Stop", BuzzerPreset::Stop},
+    {"Warning1", BuzzerPreset::Warning1},   {"Warning2", BuzzerPreset::Warning2},
+    {"Warning3", BuzzerPreset::Warning3},   {"Heartbeat", BuzzerPreset::Heartbeat},
+    {"ErrorAlert", BuzzerPreset::ErrorAlert}, {"Success", BuzzerPreset::Success},
+    {"Alarm", BuzzerPreset::Alarm},         {"MorseSOS", BuzzerPreset::MorseSOS},
+  };
+  std::printf("%-11s %10s %10s\n", "preset x3", "predicted", "simulated");
+  for (const auto& p : kPresets) {
+    const unsigned long want = Buzzer::presetDurationMs(p.preset, 3);
+    const unsigned long got = busyMs([&](Buzzer& bz) { bz.playPreset(p.preset, true, 3); });
+    std::printf("%-11s %10lu %10lu  %s\n", p.name, want, got, want == got ? "PASS" : "FAIL");
+    failed += want != got;
+  }
+
+  std::vector<uint64_t> edges;
+  const unsigned long got = busyMs([](Buzzer& bz) { bz.playPattern(table<Rhythm>(), 1); }, &edges);
+  // ON at 0, OFF 30, ON 50, OFF 110, ON 150, OFF 240, ON 320 ... second pass, final OFF at 560
+  const uint64_t want[] = {0, 30, 50, 110, 150, 240, 320, 350, 370, 430, 470, 560};
+  bool ok = got == Rhythm::duration && edges.size() == sizeof(want) / sizeof(want[0]);
+  for (size_t i = 0; ok && i < edges.size(); ++i) ok = edges[i] == want[i];
+  std::printf("%-11s %10lu %10lu  %s (%zu edges)\n", "Rhythm", (unsigned long)Rhythm::duration, got,
+              ok ? "PASS" : "FAIL", edges.size());
+  failed += !ok;
+
+  std::printf("\n%s\n", failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
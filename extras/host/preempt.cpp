@@ -0,0 +1,97 @@
+/**
+ * @file preempt.cpp
+ * @brief Host self-check of BuzzerRequestQueue: an alarm storm preempts a heartbeat, which resumes.
+ *
+ * Timeline (simulated, loop every 1 ms):
+ *  - 0 s      : Heartbeat (priority 0, infinite)
+ *  - 10.02 s  : while the heartbeat pulse is ON, Alarm (priority 2, 2 passes) is re-requested
+ *               on every loop pass until 12 s; ErrorAlert (priority 1, 1 pass) is requested once
+ *  - 30 s     : end
+ *
+ * Checks:
+ *  - the alarm plays exactly its 2 passes although it was requested ~2000 times
+ *  - ErrorAlert plays after the alarm, then the heartbeat resumes mid-pulse: the interrupted
+ *    pulse is completed (30 ms left) and the heartbeat keeps its 1 s period afterwards
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "BuzzerRequestQueue.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int kPin = 8;
+
+struct Pulse { uint64_t startMs, lenMs; };
+
+std::vector<Pulse> pulses(uint64_t t0) {
+  std::vector<Pulse> out;
+  uint64_t rise = 0;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (e.isMode || e.pin != kPin) continue;
+    if (e.value == HIGH) rise = e.us;
+    else out.push_back({(rise - t0) / 1000, (e.us - rise) / 1000});
+  }
+  return out;
+}
+
+bool check(bool ok, const char* what) {
+  std::printf("%s  %s\n", ok ? "PASS" : "FAIL", what);
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  sim::reset();
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  sim::state().events.clear();
+
+  BuzzerRequestQueue<2> sounds(bz);
+  const uint64_t t0 = sim::nowUs();
+  sounds.playPreset(0, BuzzerPreset::Heartbeat, 0);
+
+  for (uint64_t ms = 0; ms < 30000; ++ms) {
+    if (ms >= 10020 && ms < 12000) sounds.playPreset(2, BuzzerPreset::Alarm, 2);
+    if (ms == 10020) sounds.playPreset(1, BuzzerPreset::ErrorAlert, 1);
+    sounds.update();
+    sim::advanceMs(1);
+  }
+
+  const std::vector<Pulse> p = pulses(t0);
+  for (const Pulse& x : p) {
+    if (x.startMs >= 9000 && x.startMs < 17000) std::printf("  pulse @%6llu ms  %5llu ms\n",
+        (unsigned long long)x.startMs, (unsigned long long)x.lenMs);
+  }
+
+  size_t alarms = 0, errors = 0;
+  for (const Pulse& x : p) { alarms += x.lenMs >= 2000; errors += x.lenMs == 200; }
+
+  // The first alarm pulse merges with the interrupted heartbeat pulse (both ON), hence >= 2000.
+  // Heartbeat cut at 10.02 s (20 ms into its pulse); Alarm 2×2.2 s + ErrorAlert 1.9 s later it resumes.
+  const uint64_t resumeMs = 10020 + 2 * 2200 + 3 * 300 + 1000;
+  bool resumed = false, period = true;
+  for (size_t i = 0; i < p.size(); ++i) {
+    if (p[i].startMs == resumeMs && p[i].lenMs == 30) {
+      resumed = true;
+      // The rest of that cycle (950 ms gap) follows, then the regular 1 s grid.
+      for (size_t k = i + 1; k < p.size(); ++k) {
+        period &= p[k].startMs == resumeMs + 30 + 950 + (k - i - 1) * 1000 && p[k].lenMs == 50;
+      }
+    }
+  }
+
+  bool ok = true;
+  ok &= check(alarms == 2, "alarm storm plays its 2 passes once");
+  ok &= check(errors == 3, "lower-priority ErrorAlert waits, then plays");
+  ok &= check(resumed, "heartbeat resumes with the 30 ms left of its interrupted pulse");
+  ok &= check(period && sounds.isBusy(), "heartbeat keeps a 1 s period after resuming");
+  return ok ? 0 : 1;
+}
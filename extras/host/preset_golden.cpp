@@ -0,0 +1,85 @@
+/**
+ * @file preset_golden.cpp
+ * @brief Writes preset_traces.golden from the preset timings documented on ::BuzzerPreset.
+ *
+ * The timings below are transcribed by hand from the enum comments in BuzzerEngine.h, in the
+ * text syntax of stream_format.h; nothing here reads the step tables (BuzzerPattern.h), so
+ * preset_traces.cpp checks the tables against the documentation, not against themselves.
+ * After a deliberate change of a preset's timing, update the enum comment, then the text here,
+ * and regenerate:
+ *
+ *   ./preset_golden > extras/host/preset_traces.golden
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include "stream_format.h"
+
+#include <cstdio>
+
+namespace {
+
+constexpr uint32_t kInfiniteMs = 20000;   ///< window of infinite sounds
+
+struct Documented {
+  const char* name;
+  const char* doc;    ///< enum comment, verbatim
+  const char* text;   ///< one pass
+};
+
+const Documented kPresets[] = {
+  {"Init",       "1s ON, 0.1s OFF",                                  "+1000 -100"},
+  {"Stop",       "Two short beeps: 2×(100ms ON, 100ms OFF)",          "( +100 -100 ) x2"},
+  {"Warning1",   "10 bursts; each burst: 20×(5ms ON, 5ms OFF) then 200ms pause",
+                 "( ( +5 -5 ) x20 -200 ) x10"},
+  {"Warning2",   "100ms ON, 100ms OFF",                               "+100 -100"},
+  {"Warning3",   "10×(25ms ON, 25ms OFF)",                            "( +25 -25 ) x10"},
+  {"Heartbeat",  "Short pip every ~1s: ON 50ms, OFF 950ms (repeatable)", "+50 -950"},
+  {"ErrorAlert", "Triple: (ON 200ms, OFF 100ms)×3, then 1s pause",    "( +200 -100 ) x3 -1000"},
+  {"Success",    "Confirmation: ON 100ms, OFF 50ms, ON 400ms, then 200ms OFF between repeats",
+                 "+100 -50 +400 -200"},
+  {"Alarm",      "Long ON siren-like: ON 2000ms, OFF 200ms (repeatable)", "+2000 -200"},
+  // dot 1 unit, dash 3, element gap 1, letter gap 3 (the last element gap plus 2 more)
+  {"MorseSOS",   "SOS in Morse (· · · — — — · · ·), 100ms unit timing",
+                 "( +100 -100 ) x3 -200 ( +300 -100 ) x3 -200 ( +100 -100 ) x3"},
+};
+
+/** @brief " +t -t ..." for @p repeat passes (0 = infinite, cut at kInfiniteMs); the output starts OFF. */
+std::string edges(const std::vector<bzs::Step>& pass, uint32_t repeat) {
+  std::vector<bzs::Step> run;   // passes joined: a tone running into the next pass has no edge
+  uint64_t t = 0;
+  for (uint32_t n = 0; repeat ? n < repeat : t < kInfiniteMs; ++n) {
+    for (const bzs::Step& s : pass) { bzs::append(run, s); t += s.ms; }
+  }
+  std::string out;
+  t = 0;
+  bool on = false;
+  for (const bzs::Step& s : run) {
+    if (!repeat && t >= kInfiniteMs) break;
+    if (s.on != on) out += (s.on ? " +" : " -") + std::to_string(t);
+    on = s.on;
+    t += s.ms;
+  }
+  if (on && (repeat || t < kInfiniteMs)) out += " -" + std::to_string(t);
+  return out;
+}
+
+} // namespace
+
+int main() {
+  std::printf("# Edges of every BuzzerPreset: \"<name> <repeat>: +t -t ...\", ms from the start,\n"
+              "# + = ON, - = OFF. Repeat 0 (infinite) covers the first %u s.\n"
+              "# Written by preset_golden.cpp from the timings documented on BuzzerPreset:\n", kInfiniteMs / 1000);
+  for (const Documented& p : kPresets) std::printf("#   %-10s %s\n", p.name, p.doc);
+
+  for (const Documented& p : kPresets) {
+    std::vector<bzs::Step> pass;
+    std::string error;
+    if (!bzs::compile(p.text, pass, error)) {
+      std::fprintf(stderr, "%s: %s\n", p.name, error.c_str());
+      return 1;
+    }
+    for (uint32_t repeat : {1u, 3u, 0u}) std::printf("%s %u:%s\n", p.name, repeat, edges(pass, repeat).c_str());
+  }
+  return 0;
+}
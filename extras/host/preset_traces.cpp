@@ -0,0 +1,201 @@
+/**
+ * @file preset_traces.cpp
+ * @brief Regression check of every BuzzerPreset: edge traces of all play paths against golden traces.
+ *
+ * Each preset is played with repeat 1 and 3 and infinitely, and the pin's edges are rendered as
+ * text ("+t" ON, "-t" OFF, ms from the start). The expected traces come from
+ * preset_traces.golden, committed next to this file and written by preset_golden.cpp from the
+ * timings documented on ::BuzzerPreset, without the step tables; infinite sounds are compared
+ * over their first 20 s. Drivers:
+ * - blocking   : playPreset(..., false, n), which waits on the virtual clock (not for infinite)
+ * - polled     : playPreset(..., true, n) with update() every 1 ms
+ * - sleeping   : playPreset(..., true, n) with the clock jumped by msUntilNextEvent()
+ * The "tables" column compares the golden traces with the preset's ::BuzzerStep table, expanded
+ * structurally (loop words resolved without the engine). Infinite sounds also run for 600 s
+ * against that expansion, to catch drift.
+ *
+ * Option: --golden FILE, the golden traces (default extras/host/preset_traces.golden); missing ⇒ FAIL.
+ * After a deliberate timing change, regenerate them with preset_golden, never from the tables.
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int      kPin = 8;
+constexpr uint32_t kInfiniteMs = 600000;   ///< drift run of infinite sounds
+constexpr uint32_t kGoldenMs = 20000;      ///< window of infinite sounds in the golden traces
+
+struct Step { bool on; uint32_t ms; };
+
+// Expand a step table into timed steps. Loop words are resolved structurally: the `back` words
+// before a loop form its body, so nested loops become nested repetitions.
+std::vector<Step> expand(const uint16_t* table) {
+  struct Item { size_t word; std::vector<Step> steps; };
+  std::vector<Item> items;
+  for (size_t i = 0; (table[i] & BuzzerStep::OP_MASK) != BuzzerStep::OP_END; ++i) {
+    const uint16_t w = table[i];
+    const uint16_t op = w & BuzzerStep::OP_MASK;
+    if (op != BuzzerStep::OP_LOOP) {
+      items.push_back({i, {{op == BuzzerStep::OP_TONE, (uint32_t)(w & BuzzerStep::ARG_MASK)}}});
+      continue;
+    }
+    const size_t first = i - ((w >> 8) & 0x1F);
+    std::vector<Step> body;
+    while (!items.empty() && items.back().word >= first) {
+      body.insert(body.begin(), items.back().steps.begin(), items.back().steps.end());
+      items.pop_back();
+    }
+    Item loop{first, {}};
+    for (uint8_t n = 0; n < (uint8_t)(w & 0xFF); ++n) loop.steps.insert(loop.steps.end(), body.begin(), body.end());
+    items.push_back(loop);
+  }
+  std::vector<Step> out;
+  for (const Item& it : items) out.insert(out.end(), it.steps.begin(), it.steps.end());
+  return out;
+}
+
+// Edges the pin should show: passes back to back, OFF when the last pass ends, cut at `limit`.
+std::string reference(BuzzerPreset preset, uint32_t repeat, uint32_t limit) {
+  const std::vector<Step> pass = expand(BuzzerEngine::presetTable(preset));
+  std::ostringstream out;
+  bool on = false;
+  uint32_t t = 0;
+  for (uint32_t n = 0; repeat == 0 || n < repeat; ++n) {
+    for (const Step& s : pass) {
+      if (t >= limit) return out.str();
+      if (s.on != on) { out << (s.on ? " +" : " -") << t; on = s.on; }
+      t += s.ms;
+    }
+  }
+  if (on && t < limit) out << " -" << t;
+  return out.str();
+}
+
+std::string rendered(uint64_t startUs, uint32_t limit) {
+  std::ostringstream out;
+  bool on = false;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (e.isMode || e.pin != kPin || (e.value == HIGH) == on) continue;
+    const uint64_t t = (e.us - startUs) / 1000;
+    if (t >= limit) break;
+    on = e.value == HIGH;
+    out << (on ? " +" : " -") << t;
+  }
+  return out.str();
+}
+
+enum class Driver { Blocking, Polled, Sleeping };
+
+// Play and return the start time; the edges stay in sim::state().events.
+uint64_t play(BuzzerPreset preset, uint32_t repeat, Driver driver, uint32_t limit, uint64_t& simMs) {
+  sim::reset();
+  sim::setMs(1000);
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  const uint64_t start = sim::nowUs();
+
+  if (driver == Driver::Blocking) {
+    bz.playPreset(preset, false, repeat);
+  } else {
+    bz.playPreset(preset, true, repeat);
+    const uint64_t end = start + (uint64_t)limit * 1000;
+    while (bz.isBusy() && sim::nowUs() < end) {
+      if (driver == Driver::Polled) sim::advanceMs(1);
+      else                          sim::advanceMs(bz.msUntilNextEvent());
+      bz.update();
+    }
+  }
+  simMs += (sim::nowUs() - start) / 1000;
+  return start;
+}
+
+const char* name(BuzzerPreset p) {
+  static const char* const kNames[] = {"Init", "Stop", "Warning1", "Warning2", "Warning3",
+                                       "Heartbeat", "ErrorAlert", "Success", "Alarm", "MorseSOS"};
+  return kNames[(uint8_t)p];
+}
+
+// "Name repeat" -> edges, from a golden file; '#' lines are comments.
+bool readGolden(const char* path, std::map<std::string, std::string>& out) {
+  std::ifstream in(path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    const size_t colon = line.find(':');
+    if (line.empty() || line[0] == '#' || colon == std::string::npos) continue;
+    out[line.substr(0, colon)] = line.substr(colon + 1);
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const char* goldenPath = "extras/host/preset_traces.golden";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!std::strcmp(argv[i], "--golden")) goldenPath = argv[i + 1];
+  }
+
+  std::map<std::string, std::string> golden;
+  if (!readGolden(goldenPath, golden)) {
+    std::printf("cannot read golden traces %s (run from the repository root or pass --golden)\nFAILED\n", goldenPath);
+    return 1;
+  }
+
+  int failed = 0;
+  uint64_t simMs = 0;
+  const auto t0 = std::chrono::steady_clock::now();
+
+  std::printf("%-11s %6s %6s  %-8s %-8s %-8s %-8s\n", "preset", "repeat", "edges", "tables", "blocking", "polled",
+              "sleeping");
+  for (uint8_t p = 0; p <= (uint8_t)BuzzerPreset::MorseSOS; ++p) {
+    const BuzzerPreset preset = (BuzzerPreset)p;
+    for (uint32_t repeat : {1u, 3u, 0u}) {
+      const uint32_t window = repeat ? 0xFFFFFFFFu : kGoldenMs;
+      const std::string key = std::string(name(preset)) + ' ' + std::to_string(repeat);
+      const std::string tables = reference(preset, repeat, window);
+
+      const auto g = golden.find(key);
+      const bool haveGolden = g != golden.end();
+      const std::string want = haveGolden ? g->second : std::string("?");   // missing: every path fails
+      const bool tablesOk = haveGolden && tables == want;
+      failed += !tablesOk;
+
+      const char* res[3] = {"-", "", ""};
+      const Driver drivers[3] = {Driver::Blocking, Driver::Polled, Driver::Sleeping};
+      for (int d = repeat ? 0 : 1; d < 3; ++d) {
+        const uint64_t start = play(preset, repeat, drivers[d], repeat ? 0xFFFFFFFFu : kInfiniteMs, simMs);
+        bool ok = rendered(start, window) == want;
+        if (!repeat) ok = ok && rendered(start, kInfiniteMs) == reference(preset, repeat, kInfiniteMs);
+        res[d] = ok ? "PASS" : "FAIL";
+        failed += !ok;
+      }
+      size_t edges = 0;
+      for (char c : want) edges += c == '+' || c == '-';
+      std::printf("%-11s %6s %6zu  %-8s %-8s %-8s %-8s\n", name(preset),
+                  repeat ? std::to_string(repeat).c_str() : "inf", edges,
+                  tablesOk ? "PASS" : haveGolden ? "FAIL" : "MISSING", res[0], res[1], res[2]);
+    }
+  }
+
+  const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+  std::printf("\n%.0f simulated s in %.0f wall ms\n", simMs / 1000.0, wallMs);
+
+  std::printf("%s\n", failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
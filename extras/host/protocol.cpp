@@ -0,0 +1,253 @@
+/**
+ * @file protocol.cpp
+ * @brief Self-check of BuzzerProtocol: parse throughput, and edge timing with the link saturated.
+ *
+ * - throughput: a mixed stream of ASCII lines and binary frames (valid, unknown, malformed, bad
+ *   checksum) fed byte by byte; command and error counts, ns per byte and commands per second
+ * - timing: a 115200-baud link kept full for 60 s with queries, sound commands every 1.5 s, and
+ *   garbage. loop() polls the parser and updates the buzzer every 1 ms. A second buzzer gets the
+ *   same sound commands through direct calls at the millisecond each command's last byte arrives;
+ *   both pins must have identical edges, with no deadline miss. Every command must get its reply.
+ *
+ * Build with -DBUZZER_ENABLE_STATS=1: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerProtocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if !BUZZER_ENABLE_STATS
+#error "build protocol.cpp with -DBUZZER_ENABLE_STATS=1"
+#endif
+
+namespace {
+
+constexpr uint32_t kBytesPerSec = 11520;   // 115200 baud, 8N1
+
+/** @brief Bytes of a script, arriving at kBytesPerSec on the virtual clock from the first read. */
+class Link : public Stream {
+public:
+  explicit Link(const std::vector<uint8_t>& bytes) : _bytes(bytes), _startUs(sim::nowUs()) {}
+
+  int available() override {
+    uint64_t arrived = (sim::nowUs() - _startUs) * kBytesPerSec / 1000000ULL;
+    if (arrived > _bytes.size()) arrived = _bytes.size();
+    return arrived > _pos ? (int)(arrived - _pos) : 0;
+  }
+  int read() override { return available() ? _bytes[_pos++] : -1; }
+  int peek() override { return available() ? _bytes[_pos] : -1; }
+  size_t write(uint8_t) override { return 0; }
+
+private:
+  const std::vector<uint8_t>& _bytes;
+  size_t   _pos = 0;
+  uint64_t _startUs;
+};
+
+/** @brief Collects replies. */
+class Sink : public Print {
+public:
+  size_t write(uint8_t c) override { bytes.push_back(c); return 1; }
+  std::vector<uint8_t> bytes;
+};
+
+void ascii(std::vector<uint8_t>& out, const std::string& line) {
+  out.insert(out.end(), line.begin(), line.end());
+  out.push_back('\n');
+}
+
+void frame(std::vector<uint8_t>& out, std::vector<uint8_t> body, bool corrupt = false) {
+  uint8_t sum = (uint8_t)body.size();
+  for (uint8_t b : body) sum ^= b;
+  out.push_back(BuzzerProtocol::FRAME_START);
+  out.push_back((uint8_t)body.size());
+  out.insert(out.end(), body.begin(), body.end());
+  out.push_back(corrupt ? (uint8_t)~sum : sum);
+}
+
+std::vector<uint8_t> blinkFrame(uint16_t on, uint16_t off, uint16_t repeat) {
+  return {0x02, (uint8_t)on, (uint8_t)(on >> 8), (uint8_t)off, (uint8_t)(off >> 8), (uint8_t)repeat, (uint8_t)(repeat >> 8)};
+}
+
+std::vector<uint8_t> presetFrame(BuzzerPreset p, uint16_t repeat) {
+  return {0x01, (uint8_t)p, (uint8_t)repeat, (uint8_t)(repeat >> 8)};
+}
+
+void init(Buzzer& bz, int pin) {
+  bz.parameters.PIN_NUM = pin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+}
+
+std::vector<std::pair<uint64_t, uint8_t>> edges(uint8_t pin) {
+  std::vector<std::pair<uint64_t, uint8_t>> out;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (!e.isMode && e.pin == pin) out.push_back({e.us, e.value});
+  }
+  return out;
+}
+
+/** @brief Reply counts: ASCII OK / ERR / Q lines and binary frames by OP byte. */
+struct Replies {
+  uint32_t ok = 0, err = 0, query = 0, frames[256] = {}, frameErrors = 0;
+  bool edgesMonotonic = true;
+};
+
+Replies countReplies(const std::vector<uint8_t>& b) {
+  Replies r;
+  unsigned long lastEdges = 0;
+  for (size_t i = 0; i < b.size();) {
+    if (b[i] == BuzzerProtocol::FRAME_START) {
+      const uint8_t len = b[i + 1];
+      r.frames[b[i + 2]]++;
+      if (b[i + 3] != 0) r.frameErrors++;
+      i += 3 + len;
+      continue;
+    }
+    const size_t end = (size_t)(std::find(b.begin() + i, b.end(), '\n') - b.begin());
+    const std::string line(b.begin() + i, b.begin() + end);
+    i = end + 1;
+    if (line.rfind("OK", 0) == 0) r.ok++;
+    else if (line.rfind("ERR", 0) == 0) r.err++;
+    else if (line.rfind("Q ", 0) == 0) {
+      r.query++;
+      unsigned busy = 0;
+      unsigned long e = 0, misses = 0, late = 0, duty = 0;
+      if (std::sscanf(line.c_str(), "Q %u %lu %lu %lu %lu", &busy, &e, &misses, &late, &duty) != 5 || e < lastEdges) {
+        r.edgesMonotonic = false;
+      }
+      lastEdges = e;
+    }
+  }
+  return r;
+}
+
+bool throughput() {
+  std::vector<uint8_t> bytes;
+  uint32_t commands = 0, bad = 0;
+  for (int i = 0; i < 20000; ++i) {
+    ascii(bytes, "P" + std::to_string(i % 10) + "," + std::to_string(i % 4));
+    ascii(bytes, "b 30, 20, 2");
+    ascii(bytes, "Q");
+    frame(bytes, presetFrame(BuzzerPreset::Heartbeat, 0));
+    frame(bytes, blinkFrame(25, 75, 3));
+    frame(bytes, {0x04});
+    ascii(bytes, "S");
+    commands += 7;
+    if (i % 10 == 0) {
+      ascii(bytes, "P99");                       // preset out of range
+      ascii(bytes, "Z1");                        // unknown letter
+      ascii(bytes, "B10,,5");                    // empty argument
+      frame(bytes, {0x03}, true);                // bad checksum
+      frame(bytes, {0x01, 2});                   // wrong LEN for OP
+      frame(bytes, {0x7E});                      // unknown OP
+      commands += 6;
+      bad += 6;
+    }
+  }
+
+  sim::reset();
+  sim::state().record = false;
+  Buzzer bz;
+  init(bz, 8);
+  Sink sink;
+  BuzzerProtocol parser(bz, &sink);
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint8_t c : bytes) parser.feed(c);
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+  const Replies r = countReplies(sink.bytes);
+  const bool ok = parser.commands() == commands && parser.errors() == bad && r.err == 3 * bad / 6 &&
+                  r.frameErrors == 3 * bad / 6;
+  std::printf("throughput: %zu bytes, %u commands (%u rejected): %.1f ns/byte, %.2f M commands/s (host)  %s\n",
+              bytes.size(), (unsigned)parser.commands(), (unsigned)parser.errors(), ns / bytes.size(),
+              parser.commands() / ns * 1000.0, ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+bool timing() {
+  // Script: the link stays full; a sound command every 1.5 s of link time.
+  struct Sound { size_t lastByte; std::function<void(Buzzer&)> direct; };
+  std::vector<uint8_t> bytes;
+  std::vector<Sound> sounds;
+  uint32_t asciiSounds = 0, asciiQueries = 0, binQueries = 0, binSounds = 0, garbage = 0;
+  const size_t total = (size_t)kBytesPerSec * 60;
+  size_t nextSound = 0;
+  for (int n = 0; bytes.size() < total; ++n) {
+    if (bytes.size() >= nextSound) {
+      switch ((nextSound / (kBytesPerSec * 3 / 2)) % 5) {
+        case 0: ascii(bytes, "B40,60,2");
+                sounds.push_back({bytes.size(), [](Buzzer& b) { b.startBlink(40, 60, 2); }}); asciiSounds++; break;
+        case 1: frame(bytes, presetFrame(BuzzerPreset::Success, 1));
+                sounds.push_back({bytes.size(), [](Buzzer& b) { b.playPreset(BuzzerPreset::Success, true, 1); }}); binSounds++; break;
+        case 2: frame(bytes, blinkFrame(25, 25, 4));
+                sounds.push_back({bytes.size(), [](Buzzer& b) { b.startBlink(25, 25, 4); }}); binSounds++; break;
+        case 3: ascii(bytes, "P5,0");
+                sounds.push_back({bytes.size(), [](Buzzer& b) { b.playPreset(BuzzerPreset::Heartbeat, true, 0); }}); asciiSounds++; break;
+        case 4: ascii(bytes, "S");
+                sounds.push_back({bytes.size(), [](Buzzer& b) { b.stopAll(); }}); asciiSounds++; break;
+      }
+      nextSound += kBytesPerSec * 3 / 2;
+      continue;
+    }
+    if (n % 97 == 0)      { ascii(bytes, "HELLO?"); garbage++; }
+    else if (n % 3 == 0)  { frame(bytes, {0x04}); binQueries++; }
+    else                  { ascii(bytes, "Q"); asciiQueries++; }
+  }
+
+  sim::reset();
+  Buzzer viaLink, direct;
+  init(viaLink, 8);
+  init(direct, 9);
+  Sink sink;
+  BuzzerProtocol parser(viaLink, &sink);
+  Link link(bytes);
+
+  size_t next = 0;
+  const uint64_t endMs = bytes.size() * 1000ULL / kBytesPerSec + 3000;
+  for (uint64_t ms = 1; ms <= endMs; ++ms) {
+    sim::advanceMs(1);
+    parser.poll(link);
+    viaLink.update();
+    // Direct calls at the millisecond the command's last byte has arrived.
+    while (next < sounds.size() && sounds[next].lastByte * 1000000ULL <= (ms * 1000ULL) * kBytesPerSec) {
+      sounds[next++].direct(direct);
+    }
+    direct.update();
+  }
+
+  auto a = edges(8), b = edges(9);
+  bool same = a.size() == b.size();
+  for (size_t i = 0; same && i < a.size(); ++i) same = a[i] == b[i];
+
+  const Replies r = countReplies(sink.bytes);
+  const BuzzerStats s = viaLink.stats();
+  const uint32_t commands = asciiSounds + asciiQueries + binQueries + binSounds + garbage;
+  const bool replies = r.ok == asciiSounds && r.query == asciiQueries && r.err == garbage &&
+                       r.frames[0x84] == binQueries && r.frames[0x81] + r.frames[0x82] == binSounds &&
+                       r.frameErrors == 0 && r.edgesMonotonic;
+  const bool ok = same && replies && parser.commands() == commands && s.misses == 0 && s.maxLateness == 0;
+  std::printf("timing: %zu bytes at 115200 baud, %u commands (%.0f/s), %zu sound commands, %zu edges\n",
+              bytes.size(), (unsigned)parser.commands(), parser.commands() / 60.0, sounds.size(), a.size());
+  std::printf("        edges %s the direct calls, replies %s, misses %u, max lateness %u ms  %s\n",
+              same ? "identical to" : "DIFFER from", replies ? "complete" : "MISSING", (unsigned)s.misses,
+              (unsigned)s.maxLateness, ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+  failed += !throughput();
+  failed += !timing();
+  std::printf("\nBuzzerProtocol: %zu bytes of RAM (host)\n%s\n", sizeof(BuzzerProtocol), failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
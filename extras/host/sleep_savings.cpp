@@ -0,0 +1,95 @@
+/**
+ * @file sleep_savings.cpp
+ * @brief Host demo: update() calls needed per second, busy polling vs sleeping on msUntilNextEvent().
+ *
+ * For each BuzzerPreset (infinite) and a 100/900 ms blink, one simulated minute is played twice:
+ *  - polling: loop() calls update() every 1 ms (a modest 1 kHz main loop)
+ *  - sleeping: loop() calls update(), then sleeps for msUntilNextEvent() (one wakeup per event)
+ *
+ * Both runs must produce the same edges; the table shows calls/wakeups per second and the saving.
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int      kPin   = 8;
+constexpr uint64_t kRunMs = 60000;
+
+struct Run {
+  uint64_t calls = 0;
+  std::vector<sim::PinEvent> edges;
+};
+
+template <typename Start>
+Run play(Start start, bool sleeping) {
+  sim::reset();
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  sim::state().events.clear();
+  start(bz);
+
+  Run r;
+  const uint64_t endUs = sim::nowUs() + kRunMs * 1000ULL;
+  while (sim::nowUs() < endUs) {
+    bz.update();
+    r.calls++;
+    if (sleeping) {
+      const unsigned long ms = bz.msUntilNextEvent();
+      sim::advanceMs(ms == Buzzer::IDLE_FOREVER ? kRunMs : (ms ? ms : 1));
+    } else {
+      sim::advanceMs(1);
+    }
+  }
+  r.edges = sim::state().events;
+  return r;
+}
+
+bool sameEdges(const Run& a, const Run& b) {
+  if (a.edges.size() != b.edges.size()) return false;
+  for (size_t i = 0; i < a.edges.size(); ++i) {
+    if (a.edges[i].us != b.edges[i].us || a.edges[i].value != b.edges[i].value) return false;
+  }
+  return true;
+}
+
+template <typename Start>
+bool report(const char* name, Start start) {
+  const Run poll = play(start, false);
+  const Run slp  = play(start, true);
+  const double pollPerS = poll.calls * 1000.0 / kRunMs;
+  const double slpPerS  = slp.calls * 1000.0 / kRunMs;
+  const bool same = sameEdges(poll, slp);
+  std::printf("%-12s %10.1f %10.1f %8.2f%% %s\n", name, pollPerS, slpPerS,
+              100.0 * (1.0 - slpPerS / pollPerS), same ? "" : "EDGES DIFFER");
+  return same;
+}
+
+} // namespace
+
+int main() {
+  std::printf("%-12s %10s %10s %9s\n", "pattern", "poll /s", "wake /s", "saved");
+
+  static const struct { const char* name; BuzzerPreset preset; } kPresets[] = {
+    {"Init", BuzzerPreset::Init},           {"Stop", BuzzerPreset::Stop},
+    {"Warning1", BuzzerPreset::Warning1},   {"Warning2", BuzzerPreset::Warning2},
+    {"Warning3", BuzzerPreset::Warning3},   {"Heartbeat", BuzzerPreset::Heartbeat},
+    {"ErrorAlert", BuzzerPreset::ErrorAlert}, {"Success", BuzzerPreset::Success},
+    {"Alarm", BuzzerPreset::Alarm},         {"MorseSOS", BuzzerPreset::MorseSOS},
+  };
+
+  bool ok = true;
+  for (const auto& p : kPresets) {
+    ok &= report(p.name, [&](Buzzer& bz) { bz.playPreset(p.preset, true, 0); });
+  }
+  ok &= report("Blink", [](Buzzer& bz) { bz.startBlink(100, 900, 0); });
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+#pragma once
+/**
+ * @file stream_format.h
+ * @brief Host-side compiler of text sequences into BZS1 streams (BuzzerStream.h), and a decoder.
+ *
+ * Text syntax (whitespace separated, `#` starts a comment up to the end of the line):
+ * - `+MS`            ON for MS milliseconds
+ * - `-MS`            OFF for MS milliseconds
+ * - `( ... ) xN`     the enclosed steps N times (groups nest; `xN` may be omitted for once)
+ *
+ * Adjacent steps of the same level are merged and 0 ms steps dropped, so the stream has one
+ * varint per edge.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bzs {
+
+/** @brief One run of the output at a constant level. */
+struct Step {
+  bool     on;
+  uint32_t ms;
+  bool operator==(const Step& o) const { return on == o.on && ms == o.ms; }
+};
+
+constexpr uint32_t kMaxMs = 0x7FFFFFFFu;  ///< largest step the 5-byte varint holds
+
+/** @brief Append @p s to @p out, merging it into the last step if the level is the same. */
+inline bool append(std::vector<Step>& out, Step s) {
+  if (s.ms == 0) return true;
+  if (!out.empty() && out.back().on == s.on) {
+    if (kMaxMs - out.back().ms < s.ms) return false;
+    out.back().ms += s.ms;
+    return true;
+  }
+  out.push_back(s);
+  return true;
+}
+
+/**
+ * @brief Compile @p text into steps.
+ * @return false with a message naming the line in @p error on a syntax error or a too long step.
+ */
+inline bool compile(const std::string& text, std::vector<Step>& out, std::string& error) {
+  std::vector<std::vector<Step>> stack(1);
+  std::istringstream lines(text);
+  std::string line;
+  unsigned lineNo = 0;
+  bool closed = false;        // last token was ')', an `xN` may follow
+
+  auto fail = [&](const std::string& msg) {
+    error = "line " + std::to_string(lineNo) + ": " + msg;
+    return false;
+  };
+  auto number = [](const std::string& s, uint32_t& v) {
+    if (s.empty() || s.size() > 10 || s.find_first_not_of("0123456789") != std::string::npos) return false;
+    const unsigned long long n = std::stoull(s);
+    if (n > kMaxMs) return false;
+    v = (uint32_t)n;
+    return true;
+  };
+  auto close = [&](uint32_t times) {
+    std::vector<Step> body = stack.back();
+    stack.pop_back();
+    for (uint32_t i = 0; i < times; ++i) {
+      for (const Step& s : body) if (!append(stack.back(), s)) return false;
+    }
+    return true;
+  };
+
+  while (std::getline(lines, line)) {
+    ++lineNo;
+    line = line.substr(0, line.find('#'));
+    std::string spaced;
+    for (char c : line) {
+      if (c == '(' || c == ')') { spaced += ' '; spaced += c; spaced += ' '; }
+      else spaced += c;
+    }
+    std::istringstream tokens(spaced);
+    std::string tok;
+    while (tokens >> tok) {
+      uint32_t v = 0;
+      if (tok[0] == 'x' && closed) {
+        if (!number(tok.substr(1), v)) return fail("bad repeat count '" + tok + "'");
+        closed = false;
+        if (!close(v)) return fail("step longer than 2^31-1 ms");
+        continue;
+      }
+      if (closed) {
+        closed = false;
+        if (!close(1)) return fail("step longer than 2^31-1 ms");
+      }
+      if (tok == "(") {
+        stack.emplace_back();
+      } else if (tok == ")") {
+        if (stack.size() < 2) return fail("unbalanced ')'");
+        closed = true;
+      } else if ((tok[0] == '+' || tok[0] == '-') && number(tok.substr(1), v)) {
+        if (!append(stack.back(), {tok[0] == '+', v})) return fail("step longer than 2^31-1 ms");
+      } else {
+        return fail("unexpected '" + tok + "'");
+      }
+    }
+  }
+  if (closed && !close(1)) return fail("step longer than 2^31-1 ms");
+  if (stack.size() != 1) return fail("missing ')'");
+  out = stack.back();
+  return true;
+}
+
+/** @brief Encode @p steps as a BZS1 stream: magic, one varint per step, end byte. */
+inline std::vector<uint8_t> encode(const std::vector<Step>& steps) {
+  std::vector<uint8_t> out = {'B', 'Z', 'S', '1'};
+  for (const Step& s : steps) {
+    if (s.ms == 0) continue;
+    uint32_t v = (s.ms << 1) | (s.on ? 1u : 0u);
+    while (v >= 0x80) { out.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((uint8_t)v);
+  }
+  out.push_back(0);
+  return out;
+}
+
+/** @brief Decode a BZS1 stream. @return false on a bad magic, overlong varint or missing end byte. */
+inline bool decode(const std::vector<uint8_t>& in, std::vector<Step>& out) {
+  if (in.size() < 5 || in[0] != 'B' || in[1] != 'Z' || in[2] != 'S' || in[3] != '1') return false;
+  out.clear();
+  size_t i = 4;
+  while (i < in.size()) {
+    uint32_t v = 0;
+    unsigned n = 0;
+    for (;;) {
+      if (i >= in.size() || n == 5) return false;
+      const uint8_t b = in[i++];
+      v |= (uint32_t)(b & 0x7F) << (7 * n++);
+      if (!(b & 0x80)) break;
+    }
+    if (v == 0) return true;
+    out.push_back({(v & 1u) != 0, v >> 1});
+  }
+  return false;
+}
+
+/** @brief @p bytes as a PROGMEM array named @p name, for BuzzerBlobStream. */
+inline std::string toC(const std::vector<uint8_t>& bytes, const std::string& name) {
+  std::ostringstream out;
+  out << "// BZS1 stream, " << bytes.size() << " bytes\n";
+  out << "const uint8_t " << name << "[] PROGMEM = {";
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    if (i % 16 == 0) out << "\n ";
+    char hex[8];
+    std::snprintf(hex, sizeof(hex), " 0x%02X,", bytes[i]);
+    out << hex;
+  }
+  out << "\n};\n";
+  return out.str();
+}
+
+inline bool readFile(const std::string& path, std::string& out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+  std::stringstream ss;
+  ss << in.rdbuf();
+  out = ss.str();
+  return true;
+}
+
+inline bool writeFile(const std::string& path, const std::string& data) {
+  std::ofstream out(path, std::ios::binary);
+  out.write(data.data(), (std::streamsize)data.size());
+  return (bool)out;
+}
+
+} // namespace bzs
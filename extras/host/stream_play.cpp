@@ -0,0 +1,227 @@
+/**
+ * @file stream_play.cpp
+ * @brief Self-check of BuzzerStreamPlayer: compiled BZS1 sequences streamed from a file-backed
+ *        Stream and a blob play their exact edges with a 2 x 16 byte buffer.
+ *
+ * - a jingle (nested groups) and 5000 random steps of 1..3000 ms, compiled by stream_format.h and
+ *   written to stream_play.bzs, read back through a FILE*-backed Stream; polled and sleeping loops
+ * - the same file throttled to 9600 baud: no underrun
+ * - 1..3 ms steps at 300 baud: underruns are counted, the ON pulses still keep their lengths
+ * - BuzzerBlobStream over the encoded bytes; a bad magic and an overlong varint are rejected
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerStream.h"
+#include "stream_format.h"
+
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr int kPin = 8;
+
+/** @brief Stream over a file; with @p bytesPerSec > 0, available() only grows at that rate (virtual clock). */
+class FileStream : public Stream {
+public:
+  FileStream(const char* path, uint32_t bytesPerSec = 0) : _f(std::fopen(path, "rb")), _rate(bytesPerSec) {
+    if (_f) { std::fseek(_f, 0, SEEK_END); _size = (size_t)std::ftell(_f); std::fseek(_f, 0, SEEK_SET); }
+    _startUs = sim::nowUs();
+  }
+  ~FileStream() override { if (_f) std::fclose(_f); }
+
+  int available() override {
+    size_t arrived = _size;
+    if (_rate) {
+      const uint64_t n = (sim::nowUs() - _startUs) * _rate / 1000000ULL;
+      if (n < arrived) arrived = (size_t)n;
+    }
+    return arrived > _pos ? (int)(arrived - _pos) : 0;
+  }
+  int read() override {
+    if (available() == 0) return -1;
+    const int c = std::fgetc(_f);
+    if (c >= 0) ++_pos;
+    return c;
+  }
+  int peek() override {
+    if (available() == 0) return -1;
+    const int c = std::fgetc(_f);
+    if (c >= 0) std::ungetc(c, _f);
+    return c;
+  }
+  size_t write(uint8_t) override { return 0; }
+
+  uint32_t reads() const { return (uint32_t)_pos; }
+
+private:
+  std::FILE* _f;
+  uint32_t _rate;
+  size_t   _size = 0;
+  size_t   _pos = 0;
+  uint64_t _startUs = 0;
+};
+
+std::vector<bzs::Step> reference(const std::vector<bzs::Step>& steps) {
+  std::vector<bzs::Step> out;
+  for (const bzs::Step& s : steps) bzs::append(out, s);
+  if (!out.empty() && !out.front().on) out.erase(out.begin());   // the output starts OFF anyway
+  if (!out.empty() && !out.back().on) out.pop_back();             // and ends OFF
+  return out;
+}
+
+/** @brief Output as steps from the first ON edge to the last OFF edge. */
+std::vector<bzs::Step> rendered() {
+  std::vector<bzs::Step> out;
+  bool on = false;
+  uint64_t since = 0;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (e.isMode || e.pin != kPin || (e.value == HIGH) == on) continue;
+    if (on || !out.empty()) out.push_back({on, (uint32_t)((e.us - since) / 1000)});
+    on = e.value == HIGH;
+    since = e.us;
+  }
+  return out;
+}
+
+struct Run {
+  std::vector<bzs::Step> steps;
+  uint16_t underruns = 0;
+  uint32_t wakeups = 0;
+  bool     ok = false;
+};
+
+Run play(Stream& src, bool sleeping) {
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  BuzzerStreamPlayer<16> player(bz);
+  Run r;
+  r.ok = player.play(src);
+  while (player.isBusy()) {
+    const unsigned long ms = sleeping ? player.msUntilNextEvent() : 1;
+    sim::advanceMs(ms ? ms : 1);
+    player.update();
+    ++r.wakeups;
+  }
+  r.ok = r.ok && player.lastError() == BuzzerError::None;
+  r.underruns = player.underruns();
+  r.steps = rendered();
+  return r;
+}
+
+bool report(const char* name, const Run& r, const std::vector<bzs::Step>& want, bool underrunsExpected) {
+  const bool ok = r.ok && r.steps == want && (r.underruns > 0) == underrunsExpected;
+  std::printf("%-22s %6zu steps, %5u underruns, %8u wake-ups  %s\n", name, r.steps.size(),
+              (unsigned)r.underruns, (unsigned)r.wakeups, ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+std::vector<bzs::Step> onPulses(const std::vector<bzs::Step>& steps) {
+  std::vector<bzs::Step> out;
+  for (const bzs::Step& s : steps) if (s.on) out.push_back(s);
+  return out;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+
+  // ---- compile ----
+  std::string text =
+    "# jingle: rising triplets, then a long diagnostic code\n"
+    "( +60 -40 ( +20 -20 ) x3 -100 ) x20\n"
+    "( +150 -50 +50 -250 ) x50   # code 2\n";
+  std::mt19937 rng(7);
+  for (int i = 0; i < 5000; ++i) {
+    text += (i % 2 ? "-" : "+") + std::to_string(1 + rng() % 3000) + (i % 16 == 15 ? "\n" : " ");
+  }
+  std::vector<bzs::Step> steps;
+  std::string error;
+  if (!bzs::compile(text, steps, error)) { std::printf("compile: %s  FAIL\n", error.c_str()); return 1; }
+  const std::vector<uint8_t> bytes = bzs::encode(steps);
+  std::vector<bzs::Step> decoded;
+  const bool roundTrip = bzs::decode(bytes, decoded) && decoded == steps;
+  uint64_t totalMs = 0;
+  for (const bzs::Step& s : steps) totalMs += s.ms;
+  std::printf("compiled %zu steps, %llu s, into %zu bytes (%.2f bytes/step), round trip %s\n", steps.size(),
+              (unsigned long long)(totalMs / 1000), bytes.size(), (double)(bytes.size() - 5) / steps.size(),
+              roundTrip ? "PASS" : "FAIL");
+  failed += !roundTrip;
+  bzs::writeFile("stream_play.bzs", std::string(bytes.begin(), bytes.end()));
+  const std::vector<bzs::Step> want = reference(steps);
+
+  // ---- file ----
+  {
+    sim::reset();
+    FileStream f("stream_play.bzs");
+    failed += !report("file, polled", play(f, false), want, false);
+  }
+  {
+    sim::reset();
+    FileStream f("stream_play.bzs");
+    failed += !report("file, sleeping", play(f, true), want, false);
+  }
+  {
+    sim::reset();
+    FileStream f("stream_play.bzs", 960);
+    failed += !report("file at 9600 baud", play(f, true), want, false);
+  }
+
+  // ---- starved link: ON pulses keep their lengths, OFF gaps stretch ----
+  {
+    std::string fast;
+    for (int i = 0; i < 400; ++i) fast += (i % 2 ? "-" : "+") + std::to_string(1 + i % 3) + " ";
+    std::vector<bzs::Step> fs;
+    bzs::compile(fast, fs, error);
+    const std::vector<uint8_t> fb = bzs::encode(fs);
+    bzs::writeFile("stream_play_fast.bzs", std::string(fb.begin(), fb.end()));
+    sim::reset();
+    FileStream f("stream_play_fast.bzs", 30);
+    Run r = play(f, false);
+    r.steps = onPulses(r.steps);
+    failed += !report("1..3 ms at 300 baud", r, onPulses(reference(fs)), true);
+    std::remove("stream_play_fast.bzs");
+  }
+
+  // ---- blob ----
+  {
+    sim::reset();
+    BuzzerBlobStream blob(bytes.data(), bytes.size(), false);
+    failed += !report("blob", play(blob, true), want, false);
+  }
+
+  // ---- rejected data ----
+  {
+    sim::reset();
+    Buzzer bz;
+    bz.parameters.PIN_NUM = kPin;
+    bz.init();
+    BuzzerStreamPlayer<8> player(bz);
+
+    static const uint8_t kBadMagic[] = {'B', 'Z', 'T', '1', 0x41, 0x00};
+    BuzzerBlobStream a(kBadMagic, sizeof(kBadMagic), false);
+    const bool magicOk = !player.play(a) && player.lastError() == BuzzerError::InvalidStream && !player.isBusy();
+
+    static const uint8_t kOverlong[] = {'B', 'Z', 'S', '1', 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x00};
+    BuzzerBlobStream b(kOverlong, sizeof(kOverlong), false);
+    const bool longOk = !player.play(b) && player.lastError() == BuzzerError::InvalidStream && !player.isBusy();
+
+    std::vector<bzs::Step> s;
+    const bool syntaxOk = !bzs::compile("( +10 -10", s, error) && !bzs::compile("+10 ) x2", s, error) &&
+                          !bzs::compile("+10 ms", s, error);
+    const bool ok = magicOk && longOk && syntaxOk;
+    std::printf("%-22s magic %s, overlong varint %s, syntax errors %s  %s\n", "rejected data",
+                magicOk ? "ok" : "BAD", longOk ? "ok" : "BAD", syntaxOk ? "ok" : "BAD", ok ? "PASS" : "FAIL");
+    failed += !ok;
+  }
+
+  std::printf("\nBuzzerStreamPlayer<16>: %zu bytes of RAM\n%s\n", sizeof(BuzzerStreamPlayer<16>),
+              failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file tick_thread.cpp
+ * @brief Host check of the interrupt drive mode: Buzzer::tick() fed through BuzzerCommandQueue.
+ *
+ *  1. Ordering: the main thread pushes a numbered command stream while a consumer thread pops it;
+ *     every command must arrive exactly once, in order (the queue is the only shared state).
+ *  2. Timing, on one thread and the virtual clock: the main loop posts a Heartbeat, then stalls
+ *     for random stretches of 0..300 ms. A stall advances the clock 1 ms at a time, and each
+ *     millisecond the simulated 1 kHz timer interrupt calls bz.tick(millis(), queue). After the
+ *     stalls the loop posts stop. Every edge of the ticked buzzer must be at most one timer
+ *     period late on its nominal 50/950 ms grid. A second buzzer, given the same commands but
+ *     only updated by the main loop between stalls, must be far later, so the stalls are real.
+ *
+ * Exits with status 0 when both checks pass.
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "BuzzerCommandQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr int kPin = 8;
+
+bool checkOrdering() {
+  constexpr uint32_t kCount = 200000;
+  BuzzerCommandQueue<16> q;
+  uint32_t errors = 0;
+
+  std::thread consumer([&] {
+    uint32_t expected = 0;
+    BuzzerCommand c;
+    while (expected < kCount) {
+      if (!q.pop(c)) { std::this_thread::yield(); continue; }
+      if (c.repeat != expected) errors++;
+      expected++;
+    }
+  });
+
+  uint32_t fullHits = 0;
+  for (uint32_t i = 0; i < kCount; ++i) {
+    BuzzerCommand c;
+    c.type = BuzzerCommand::Type::StartBlink;
+    c.repeat = i;
+    while (!q.push(c)) { fullHits++; std::this_thread::yield(); }
+  }
+  consumer.join();
+
+  std::printf("ordering: %u commands, %u out of order, producer saw full queue %u times\n",
+              (unsigned)kCount, (unsigned)errors, (unsigned)fullHits);
+  return errors == 0;
+}
+
+Buzzer* gTicked = nullptr;               // driven by the "interrupt"
+BuzzerCommandQueue<8>* gQueue = nullptr;
+
+/** @brief Simulated 1 kHz timer interrupt. */
+void timerIsr() { gTicked->tick(millis(), *gQueue); }
+
+/** @brief The main loop blocks for @p ms: the clock runs on, the timer interrupt still fires. */
+void stallMs(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; ++i) {
+    sim::advanceMs(1);
+    timerIsr();
+  }
+}
+
+/** @brief Worst lateness (µs) of @p pin's edges on the Heartbeat grid of its first edge. */
+uint64_t maxLateness(uint8_t pin, uint32_t& edges, uint8_t& level) {
+  uint64_t worst = 0, t0 = 0;
+  edges = 0;
+  level = LOW;
+  const auto& ev = sim::state().events;
+  size_t lastEdge = 0;
+  for (size_t i = 0; i < ev.size(); ++i) if (!ev[i].isMode && ev[i].pin == pin) lastEdge = i;
+  for (size_t i = 0; i < ev.size(); ++i) {
+    const sim::PinEvent& e = ev[i];
+    if (e.isMode || e.pin != pin || e.value == level) continue;
+    if (edges == 0) t0 = e.us;
+    const uint64_t nominal = e.value == HIGH ? 0 : 50000;
+    const uint64_t late = ((e.us - t0) % 1000000 + 1000000 - nominal) % 1000000;
+    if (!(e.value == LOW && i == lastEdge) && late > worst) worst = late;   // stop may cut a pulse
+    level = e.value;
+    edges++;
+  }
+  return worst;
+}
+
+bool checkTiming() {
+  constexpr uint8_t kPolledPin = kPin + 1;
+  sim::reset();
+  Buzzer ticked, polled;
+  ticked.parameters.PIN_NUM = kPin;
+  polled.parameters.PIN_NUM = kPolledPin;
+  ticked.parameters.ACTIVE_MODE = polled.parameters.ACTIVE_MODE = 1;
+  if (!ticked.init() || !polled.init()) return false;
+  polled.setCatchUp(BuzzerCatchUp::Strict);   // keeps the grid, only the edges are late
+  sim::state().events.clear();
+
+  BuzzerCommandQueue<8> q;
+  gTicked = &ticked;
+  gQueue = &q;
+
+  // Busy main loop: random blocking sections; the ticked buzzer is only reached through q.
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<uint32_t> stall(0, 300);
+  q.playPreset(BuzzerPreset::Heartbeat, 0);
+  polled.playPreset(BuzzerPreset::Heartbeat, true, 0);
+  for (int i = 0; i < 600; ++i) {
+    stallMs(stall(rng));
+    polled.update();
+  }
+  q.stop();
+  polled.stopAll();
+  stallMs(20);
+
+  uint32_t edges = 0, polledEdges = 0;
+  uint8_t level = LOW, polledLevel = LOW;
+  const uint64_t late = maxLateness(kPin, edges, level);
+  const uint64_t polledLate = maxLateness(kPolledPin, polledEdges, polledLevel);
+
+  std::printf("timing: %lu virtual ms of stalls; tick(): %u edges, max lateness %lu us, final level %s\n",
+              (unsigned long)millis(), (unsigned)edges, (unsigned long)late, level == LOW ? "OFF" : "ON");
+  std::printf("        update() between stalls: %u edges, max lateness %lu us\n", (unsigned)polledEdges,
+              (unsigned long)polledLate);
+  return edges > 100 && late <= 1000 && level == LOW && polledLate > 100000;
+}
+
+} // namespace
+
+int main() {
+  const bool ok = checkOrdering() & checkTiming();
+  std::printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file tone_wave.cpp
+ * @brief Host self-check of the PassiveBuzzer square wave (BuzzerTone.h).
+ *
+ * tick() runs at SAMPLE_HZ = 20 kHz on the virtual clock; the frequency at a point in time is
+ * measured by counting rising edges in a 50 ms window around it.
+ *
+ * Checks:
+ *  - steady tones: 1000 Hz and 1234 Hz average frequency, 1 kHz periods of exactly 20 ticks
+ *  - linear sweep 500 → 2500 Hz: 1000 / 1500 / 2000 Hz at 1/4, 1/2, 3/4
+ *  - exponential sweep 500 → 2000 Hz: 707 / 1000 / 1414 Hz (geometric) at 1/4, 1/2, 3/4
+ *  - Alarm preset: 700 → 1800 → 700 Hz siren over 2 s, then 200 ms of silence
+ *  - Heartbeat preset: 50 ms bursts of CARRIER_HZ once per second, silent in between
+ * and prints the host cost of BuzzerToneEngine::tick().
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "BuzzerTone.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int      kPin = 9;
+constexpr uint32_t kSampleHz = 20000;
+constexpr uint32_t kTickUs = 1000000 / kSampleHz;
+
+PassiveBuzzer pz;
+std::vector<uint64_t> rises;   // µs since the sound started
+uint64_t t0 = 0;
+
+void begin() {
+  sim::reset();
+  pz.parameters.PIN_NUM = kPin;
+  pz.parameters.SAMPLE_HZ = kSampleHz;
+  pz.init();
+  sim::state().events.clear();
+  rises.clear();
+  t0 = sim::nowUs();
+}
+
+void run(uint32_t ms) {
+  for (uint32_t n = 0; n < ms * (kSampleHz / 1000); ++n) { pz.tick(); sim::advanceUs(kTickUs); }
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (!e.isMode && e.pin == kPin && e.value == HIGH) rises.push_back(e.us - t0);
+  }
+  sim::state().events.clear();
+}
+
+// Average frequency in [centerMs - 25, centerMs + 25).
+double hzAt(uint32_t centerMs) {
+  const uint64_t a = (centerMs - 25) * 1000ULL, b = (centerMs + 25) * 1000ULL;
+  size_t n = 0;
+  for (uint64_t t : rises) n += (t >= a && t < b);
+  return n / 0.05;
+}
+
+bool near(double got, double want, double tol) { return std::fabs(got - want) <= want * tol; }
+
+bool check(bool ok, const char* what) {
+  std::printf("%s  %s\n", ok ? "PASS" : "FAIL", what);
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  bool ok = true;
+
+  begin(); pz.tone(1000); run(1000);
+  bool exact = true;
+  for (size_t i = 1; i < rises.size(); ++i) exact &= rises[i] - rises[i - 1] == 1000;
+  ok &= check(rises.size() == 1000 && exact, "1000 Hz: 1000 periods of exactly 20 ticks");
+
+  begin(); pz.tone(1234); run(1000);
+  ok &= check(rises.size() >= 1233 && rises.size() <= 1235, "1234 Hz: 1234 +-1 periods per second");
+
+  static const BuzzerToneStep kLinear[] PROGMEM = { BuzzerTone::sweep(500, 2500, 1000), BuzzerTone::end() };
+  begin(); pz.playTones(kLinear); run(1100);
+  std::printf("        linear   %6.0f %6.0f %6.0f Hz\n", hzAt(250), hzAt(500), hzAt(750));
+  ok &= check(near(hzAt(250), 1000, 0.03) && near(hzAt(500), 1500, 0.03) && near(hzAt(750), 2000, 0.03),
+              "linear sweep 500->2500 Hz");
+
+  static const BuzzerToneStep kExp[] PROGMEM = { BuzzerTone::sweepExp(500, 2000, 1000), BuzzerTone::end() };
+  begin(); pz.playTones(kExp); run(1100);
+  std::printf("        exp      %6.0f %6.0f %6.0f Hz\n", hzAt(250), hzAt(500), hzAt(750));
+  ok &= check(near(hzAt(250), 707, 0.03) && near(hzAt(500), 1000, 0.03) && near(hzAt(750), 1414, 0.03),
+              "exponential sweep 500->2000 Hz");
+
+  begin(); pz.playPreset(BuzzerPreset::Alarm, 2); run(4500);
+  std::printf("        alarm    %6.0f %6.0f %6.0f %6.0f Hz, rises in 2.0-2.2 s: %u\n",
+              hzAt(50), hzAt(975), hzAt(1950), hzAt(2250), (unsigned)[] {
+                size_t n = 0; for (uint64_t t : rises) n += (t >= 2001000 && t < 2200000); return n; }());
+  bool silent = true;
+  for (uint64_t t : rises) silent &= !(t >= 2001000 && t < 2200000) && t < 4400000;
+  ok &= check(near(hzAt(975), 1770, 0.05) && hzAt(50) < 800 && hzAt(1950) < 800 && silent,
+              "Alarm preset: swept siren with its 200 ms pause, 2 passes");
+
+  begin(); pz.playPreset(BuzzerPreset::Heartbeat, 3); run(3500);
+  size_t inBurst = 0;
+  for (uint64_t t : rises) inBurst += (t % 1000000) < 50000;
+  ok &= check(inBurst == rises.size() && rises.size() >= 3 * 134 && rises.size() <= 3 * 136,
+              "Heartbeat preset: 3 bursts of 50 ms at 2700 Hz");
+
+  // Host cost of the generator alone.
+  BuzzerToneEngine eng;
+  eng.begin(kSampleHz);
+  eng.playTones(kExp, 0);
+  const int kTicks = 50000000;
+  uint32_t highs = 0;
+  const auto a = std::chrono::steady_clock::now();
+  for (int i = 0; i < kTicks; ++i) highs += eng.tick();
+  const auto b = std::chrono::steady_clock::now();
+  std::printf("\nBuzzerToneEngine::tick(): %.2f ns/tick on this host (%u high samples)\n",
+              std::chrono::duration<double, std::nano>(b - a).count() / kTicks, (unsigned)highs);
+  return ok ? 0 : 1;
+}
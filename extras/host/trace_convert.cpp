@@ -0,0 +1,42 @@
+/**
+ * @file trace_convert.cpp
+ * @brief Convert a BZT1 edge-trace dump (Buzzer::dumpTrace(), e.g. a Serial capture) to VCD and WAV.
+ *
+ * Usage: trace_convert <dump.txt> <out.vcd> [out.wav] [tone_hz]
+ *  - the dump may be surrounded by other serial output; the first BZT1 block is used
+ *  - the VCD has one wire `out` with the trace's tick as timescale (1 ms or 1 µs)
+ *  - the WAV plays a tone_hz square wave (default 2700 Hz) while the output is ON
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include "trace_format.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s <dump.txt> <out.vcd> [out.wav] [tone_hz]\n", argv[0]);
+    return 2;
+  }
+
+  std::string text;
+  trace::Trace t;
+  if (!trace::readFile(argv[1], text)) { std::fprintf(stderr, "cannot read %s\n", argv[1]); return 1; }
+  if (!trace::parse(text, t))          { std::fprintf(stderr, "no complete BZT1 block in %s\n", argv[1]); return 1; }
+
+  if (!trace::writeVcd(argv[2], t)) { std::fprintf(stderr, "cannot write %s\n", argv[2]); return 1; }
+  if (argc >= 4) {
+    const uint32_t hz = argc >= 5 ? (uint32_t)std::strtoul(argv[4], nullptr, 10) : 2700;
+    if (!trace::writeWav(argv[3], t, 22050, hz)) { std::fprintf(stderr, "cannot write %s\n", argv[3]); return 1; }
+  }
+
+  uint64_t onTicks = 0, since = t.startTick;
+  bool on = t.startLevel;
+  for (const auto& e : t.edges) { if (on) onTicks += e.first - since; since = e.first; on = e.second; }
+  const uint64_t span = (t.edges.empty() ? t.startTick : t.edges.back().first) - t.startTick;
+  std::printf("%zu edges over %llu %s, ON %llu %s\n", t.edges.size(), (unsigned long long)span,
+              t.micros ? "us" : "ms", (unsigned long long)onTicks, t.micros ? "us" : "ms");
+  return 0;
+}
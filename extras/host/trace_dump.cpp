@@ -0,0 +1,125 @@
+/**
+ * @file trace_dump.cpp
+ * @brief Self-check of the BUZZER_ENABLE_TRACE edge ring: dump, decode and compare with the pin log.
+ *
+ * Each case plays a sound with a jittery loop, prints the trace through dumpTrace() into a buffer,
+ * decodes it with trace_format.h and checks that the decoded edges equal the newest edges of the
+ * simulated pin (the ring keeps only the last BUZZER_TRACE_SIZE entries):
+ * - Success then Morse "PARIS PARIS PARIS" (ring wraps with the default 64 entries)
+ * - a Heartbeat pulse, 100 s of silence, one more pulse (long-gap entries)
+ * - a 300/700 µs blink in the Micros timebase
+ *
+ * The first case is also written to trace_dump.bzt for trace_convert.
+ *
+ * Build (trace must be enabled for every file): see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "Buzzer.h"
+#include "trace_format.h"
+
+#include <cstdio>
+#include <string>
+
+#if !BUZZER_ENABLE_TRACE
+#error "build with -DBUZZER_ENABLE_TRACE=1"
+#endif
+
+namespace {
+
+constexpr int kPin = 8;
+
+/** @brief Print sink that appends to a std::string. */
+class StringPrint : public Print {
+public:
+  std::string text;
+  size_t write(uint8_t c) override { text += (char)c; return 1; }
+};
+
+/** @brief Level changes of kPin in the event log, in ms or µs. */
+std::vector<std::pair<uint64_t, bool>> pinEdges(bool micros) {
+  std::vector<std::pair<uint64_t, bool>> out;
+  bool level = false;
+  for (const sim::PinEvent& e : sim::state().events) {
+    if (e.isMode || e.pin != kPin || (e.value == HIGH) == level) continue;
+    level = e.value == HIGH;
+    out.push_back({micros ? e.us : e.us / 1000, level});
+  }
+  return out;
+}
+
+/** @brief Advance by @p ms with update() every 1..4 ms. */
+void run(Buzzer& bz, uint32_t ms) {
+  for (uint32_t t = 0, i = 0; t < ms; ++i) {
+    const uint32_t step = 1 + (i * 7) % 4;
+    sim::advanceMs(step);
+    t += step;
+    bz.update();
+  }
+}
+
+bool check(const char* name, Buzzer& bz, std::string* dump = nullptr) {
+  StringPrint p;
+  bz.dumpTrace(p);
+  if (dump) *dump = p.text;
+
+  trace::Trace t;
+  const bool micros = bz.timebase() == BuzzerTimebase::Micros;
+  const bool parsed = trace::parse(p.text, t);
+  const auto want = pinEdges(micros);
+
+  bool ok = parsed && t.micros == micros && t.edges.size() <= want.size() && !t.edges.empty();
+  if (ok) {
+    const size_t off = want.size() - t.edges.size();
+    for (size_t i = 0; i < t.edges.size() && ok; ++i) ok = t.edges[i] == want[off + i];
+  }
+  std::printf("%-34s %3u entries, %3zu/%3zu edges decoded  %s\n", name, (unsigned)bz.trace().size(),
+              t.edges.size(), want.size(), ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+Buzzer make() {
+  sim::reset();
+  Buzzer bz;
+  bz.parameters.PIN_NUM = kPin;
+  bz.parameters.ACTIVE_MODE = 1;
+  bz.init();
+  return bz;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+
+  {
+    Buzzer bz = make();
+    bz.playPreset(BuzzerPreset::Success, false, 1);
+    run(bz, 1500);
+    bz.playMorse("PARIS PARIS PARIS", 20);
+    run(bz, 10000);
+    std::string dump;
+    failed += !check("Success + Morse PARIS x3 (wraps)", bz, &dump);
+    if (FILE* f = std::fopen("trace_dump.bzt", "w")) { std::fputs(dump.c_str(), f); std::fclose(f); }
+  }
+  {
+    Buzzer bz = make();
+    bz.playPreset(BuzzerPreset::Heartbeat, false, 1);
+    run(bz, 2000);
+    sim::advanceMs(100000);
+    bz.update();
+    bz.playPreset(BuzzerPreset::Heartbeat, false, 1);
+    run(bz, 2000);
+    failed += !check("Heartbeat, 100 s idle, Heartbeat", bz);
+  }
+  {
+    Buzzer bz = make();
+    bz.setTimebase(BuzzerTimebase::Micros);
+    bz.startBlinkUs(300, 700, 20);
+    for (int i = 0; i < 40000; ++i) { sim::advanceUs(1); bz.update(); }
+    failed += !check("300/700 us blink (Micros)", bz);
+  }
+
+  std::printf("\nfirst dump written to trace_dump.bzt; %s\n", failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}
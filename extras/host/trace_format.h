@@ -0,0 +1,125 @@
+#pragma once
+/**
+ * @file trace_format.h
+ * @brief Host-side reader of BZT1 edge-trace dumps (BuzzerTrace.h) and VCD/WAV writers.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace trace {
+
+/** @brief One decoded dump: start state plus the level changes after it. */
+struct Trace {
+  bool     micros = false;    ///< ticks are µs (else ms)
+  uint64_t startTick = 0;     ///< time of the oldest entry
+  bool     startLevel = false;
+  std::vector<std::pair<uint64_t, bool>> edges; ///< (tick, new level), ascending
+};
+
+/**
+ * @brief Find the first "BZT1" block in @p text (other serial output may surround it) and decode it.
+ * @return false if no complete block is found.
+ *
+ * The oldest entry only anchors the start level and time: whether it was an edge or a gap entry
+ * depends on the entry before it, which the ring may have overwritten.
+ */
+inline bool parse(const std::string& text, Trace& out) {
+  const size_t at = text.find("BZT1");
+  if (at == std::string::npos) return false;
+  std::istringstream in(text.substr(at + 4));
+
+  std::string unit;
+  unsigned long long end = 0;
+  size_t count = 0;
+  if (!(in >> unit >> end >> count) || (unit != "ms" && unit != "us")) return false;
+
+  std::vector<uint16_t> e(count);
+  for (size_t i = 0; i < count; ++i) {
+    std::string tok;
+    if (!(in >> tok)) return false;
+    e[i] = (uint16_t)std::stoul(tok, nullptr, 16);
+  }
+  std::string t1, t2;
+  if (!(in >> t1 >> t2) || t1 != "BZT" || t2 != "END") return false;
+
+  out = Trace();
+  out.micros = unit == "us";
+  if (count == 0) { out.startTick = end; return true; }
+
+  // Relative times first, then shift so that the newest entry lands on `end`.
+  std::vector<std::pair<uint64_t, bool>> rel;
+  uint64_t t = 0;
+  bool level = (e[0] & 0x8000) != 0;
+  for (size_t i = 1; i < count; ++i) {
+    const bool l = (e[i] & 0x8000) != 0;
+    const uint64_t d = e[i] & 0x7FFF;
+    if (l == level) { t += d << 15; continue; }   // long gap
+    t += d;
+    level = l;
+    rel.push_back({t, l});
+  }
+  out.startTick = end - t;
+  out.startLevel = (e[0] & 0x8000) != 0;
+  for (const auto& r : rel) out.edges.push_back({out.startTick + r.first, r.second});
+  return true;
+}
+
+inline bool readFile(const std::string& path, std::string& text) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) return false;
+  std::ostringstream ss;
+  ss << f.rdbuf();
+  text = ss.str();
+  return true;
+}
+
+/** @brief Write @p t as a one-signal VCD file (timescale = the trace's tick). */
+inline bool writeVcd(const std::string& path, const Trace& t) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (!f) return false;
+  std::fprintf(f, "$timescale 1%s $end\n$scope module buzzer $end\n$var wire 1 ! out $end\n"
+                  "$upscope $end\n$enddefinitions $end\n", t.micros ? "us" : "ms");
+  std::fprintf(f, "#%llu\n$dumpvars\n%d!\n$end\n", (unsigned long long)t.startTick, t.startLevel ? 1 : 0);
+  for (const auto& e : t.edges) std::fprintf(f, "#%llu\n%d!\n", (unsigned long long)e.first, e.second ? 1 : 0);
+  return std::fclose(f) == 0;
+}
+
+/**
+ * @brief Render @p t as 16-bit mono PCM: a @p toneHz square wave while ON (an active buzzer's
+ *        own oscillator), silence while OFF, plus @p tailMs after the last edge.
+ * @note Limited to 10 minutes of audio.
+ */
+inline bool writeWav(const std::string& path, const Trace& t, uint32_t rate = 22050,
+                     uint32_t toneHz = 2700, uint32_t tailMs = 200) {
+  const double tickS = t.micros ? 1e-6 : 1e-3;
+  const uint64_t lastTick = t.edges.empty() ? t.startTick : t.edges.back().first;
+  double seconds = (double)(lastTick - t.startTick) * tickS + tailMs / 1000.0;
+  if (seconds > 600.0) seconds = 600.0;
+  const uint32_t n = (uint32_t)(seconds * rate);
+
+  std::vector<int16_t> pcm(n, 0);
+  size_t next = 0;
+  bool on = t.startLevel;
+  for (uint32_t i = 0; i < n; ++i) {
+    const uint64_t tick = t.startTick + (uint64_t)(i / (double)rate / tickS);
+    while (next < t.edges.size() && t.edges[next].first <= tick) on = t.edges[next++].second;
+    if (on) pcm[i] = ((uint64_t)i * toneHz * 2 / rate) & 1 ? -12000 : 12000;
+  }
+
+  FILE* f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  auto u32 = [f](uint32_t v) { uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)}; std::fwrite(b, 1, 4, f); };
+  auto u16 = [f](uint16_t v) { uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)}; std::fwrite(b, 1, 2, f); };
+  std::fwrite("RIFF", 1, 4, f); u32(36 + n * 2); std::fwrite("WAVE", 1, 4, f);
+  std::fwrite("fmt ", 1, 4, f); u32(16); u16(1); u16(1); u32(rate); u32(rate * 2); u16(2); u16(16);
+  std::fwrite("data", 1, 4, f); u32(n * 2);
+  for (int16_t s : pcm) u16((uint16_t)s);
+  return std::fclose(f) == 0;
+}
+
+} // namespace trace
@@ -0,0 +1,108 @@
+/**
+ * @file volume.cpp
+ * @brief Self-check of VolumeBuzzer: envelope shape, analogWrite() path, sigma-delta soft PWM.
+ *
+ * - pin 9 (hardware PWM): attack 100 ms to 255, decay 100 ms to 100, sampled over a 400 ms pulse;
+ *   analogWrite() must follow the duty, inverted for an active-LOW buzzer
+ * - pin 8 (soft PWM): pwmTick() at 20 kHz for several volumes; ON-tick ratio vs duty/256 and the
+ *   longest run of equal levels (short runs = switching far above the audio band)
+ * - cost per pwmTick()
+ *
+ * Build: see extras/host/README.md
+ */
+
+#include <Arduino.h>
+#include "BuzzerVolume.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+bool envelopeCheck(uint8_t activeMode) {
+  sim::reset();
+  VolumeBuzzer vb;
+  vb.parameters.PIN_NUM = 9;
+  vb.parameters.ACTIVE_MODE = activeMode;
+  if (!vb.init() || !vb.hardwarePwm()) return false;
+
+  BuzzerEnvelope env;
+  env.attackMs = 100;
+  env.decayMs = 100;
+  env.level = 100;
+  vb.setEnvelope(env);
+  vb.startBlink(400, 100, 1);
+
+  static const struct { uint32_t ms; uint8_t duty; } kExpect[] = {
+    {0, 0}, {50, 127}, {100, 255}, {150, 178}, {200, 100}, {399, 100}, {400, 0}, {450, 0},
+  };
+  bool ok = true;
+  uint32_t t = 0;
+  std::printf("ACTIVE_MODE=%u  ms:duty", activeMode);
+  for (const auto& e : kExpect) {
+    for (; t < e.ms; ++t) { sim::advanceMs(1); vb.update(); }
+    const uint8_t pin = sim::state().analog[9];
+    const uint8_t want = activeMode ? e.duty : (uint8_t)(255 - e.duty);
+    // The initial OFF level is written with digitalWrite(), before any analogWrite().
+    const bool pinOk = (t == 0) || pin == want;
+    std::printf(" %u:%u", (unsigned)e.ms, (unsigned)vb.duty());
+    ok = ok && vb.duty() == e.duty && pinOk;
+  }
+  std::printf("  %s\n", ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+bool softCheck(uint8_t volume) {
+  sim::reset();
+  VolumeBuzzer vb;
+  vb.parameters.PIN_NUM = 8;
+  vb.parameters.ACTIVE_MODE = 1;
+  if (!vb.init() || vb.hardwarePwm()) return false;
+  vb.setVolume(volume);
+  vb.startBlink(200, 100, 1);
+
+  uint32_t onTicks = 0, ticks = 0, run = 0, maxRun = 0;
+  uint8_t last = LOW;
+  for (uint32_t i = 0; i < 20 * 199; ++i) {             // 20 kHz over the first 199 ms of the pulse
+    if (i % 20 == 0) vb.update();
+    sim::advanceUs(50);
+    vb.pwmTick();
+    const uint8_t level = sim::pinLevel(8);
+    onTicks += level == HIGH;
+    ticks++;
+    run = level == last ? run + 1 : 1;
+    if (run > maxRun) maxRun = run;
+    last = level;
+  }
+  const double ratio = 256.0 * onTicks / ticks;
+  const bool ok = std::abs(ratio - volume) < 1.0 + (volume == 255);
+  std::printf("soft PWM volume %3u: duty %6.1f/256, longest run %3u ticks  %s\n",
+              (unsigned)volume, ratio, (unsigned)maxRun, ok ? "PASS" : "FAIL");
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  int failed = 0;
+  failed += !envelopeCheck(1);
+  failed += !envelopeCheck(0);
+  for (uint8_t v : {16, 64, 128, 200, 255}) failed += !softCheck(v);
+
+  sim::reset();
+  VolumeBuzzer vb;
+  vb.parameters.PIN_NUM = 8;
+  vb.parameters.ACTIVE_MODE = 1;
+  vb.init();
+  vb.setVolume(77);
+  vb.startBlink(60000, 100, 1);
+  vb.update();
+  sim::state().record = false;
+  const uint32_t n = 20000000;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; ++i) vb.pwmTick();
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+  std::printf("\npwmTick(): %.2f ns per call (host)\n%s\n", ns, failed ? "FAILED" : "all PASS");
+  return failed ? 1 : 0;
+}